@@ -1,6 +1,6 @@
 # mpc.m4
 #
-# Copyright (C) 2008, 2009, 2010, 2011, 2012, 2014, 2018, 2023, 2024 INRIA
+# Copyright (C) 2008, 2009, 2010, 2011, 2012, 2014, 2018, 2023, 2024, 2026 INRIA
 #
 # This file is part of GNU MPC.
 #
@@ -195,3 +195,35 @@ AC_DEFUN([MPC_GITVERSION], [
       ])
    fi
 ])
+
+
+#
+# SYNOPSIS
+#
+#
+# MPC_THREAD_LOCAL
+#
+# DESCRIPTION
+#
+# Look for a storage class specifier for thread local variables, define
+# MPC_THREAD_ATTR to it and HAVE_THREAD_LOCAL to 1. If none is found,
+# MPC_THREAD_ATTR is defined to nothing and the library keeps no state
+# between calls, that is, no scratch contexts nor cached constants.
+#
+AC_DEFUN([MPC_THREAD_LOCAL], [
+   AC_MSG_CHECKING([for thread local storage])
+   mpc_thread_attr=no
+   for attr in _Thread_local __thread; do
+      AC_LINK_IFELSE(
+         [AC_LANG_PROGRAM([[static $attr int x;]], [[x = 17; return x;]])],
+         [mpc_thread_attr=$attr; break])
+   done
+   AC_MSG_RESULT([$mpc_thread_attr])
+   AS_IF([test "x$mpc_thread_attr" = "xno"],
+      [mpc_thread_attr=
+       AC_MSG_WARN([no thread local storage, caches are disabled])],
+      [AC_DEFINE([HAVE_THREAD_LOCAL], 1,
+          [Define to 1 if thread local variables are supported])])
+   AC_DEFINE_UNQUOTED([MPC_THREAD_ATTR], [$mpc_thread_attr],
+      [Storage class specifier for thread local variables])
+])
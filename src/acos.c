@@ -1,6 +1,6 @@
 /* mpc_acos -- arccosine of a complex number.
 
-Copyright (C) 2009, 2010, 2011, 2012, 2020, 2024 INRIA
+Copyright (C) 2009, 2010, 2011, 2012, 2020, 2024, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -21,6 +21,267 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 #include <stdio.h>    /* for MPC_ASSERT */
 #include "mpc-impl.h"
 
+static int
+acos_branch_point (mpc_ptr z, mpc_srcptr op, mpfr_prec_t p_re,
+                   mpfr_prec_t p_im, mpc_rnd_t rnd)
+  /* Assume op = x + i*y with x = 1 or x = -1 and y non-zero, and let w be
+     the precision of both parts of z. If |y| < 2^(-w-3), put into z an
+     approximation of acos (op) from which the correctly rounded result in
+     precision p_re + i*p_im and its ternary value are obtained by rounding
+     in direction rnd, and return 1; otherwise return 0.
+     By formula 15.1.6 of Abramowitz & Stegun, for |t| < 2,
+        acos (1 - t) = sqrt (2t) * F (1/2, 1/2; 3/2; t/2)
+     where the coefficients of the hypergeometric series F are positive,
+     decreasing and 1, 1/6, 3/40, ...; so for 0 < y <= 1 and t = -i*y,
+     acos (1 + i*y) = sqrt (y) * (1 - i) * (1 - i*y/12 + eta) with
+     |eta| <= 3/40 * (y/2)^2 / (1 - y/2) <= y^2/40, and
+        Re (acos (1 + i*y)) = sqrt (y) * (1 - y/12 + eta1),
+        Im (acos (1 + i*y)) = -sqrt (y) * (1 + y/12 + eta2)
+     with |eta1|, |eta2| <= sqrt (2) * y^2/40 < y^2/28. Hence
+        sqrt (y) * (1 - y/6) < Re (acos (1 + i*y)) < sqrt (y) and
+        sqrt (y) < -Im (acos (1 + i*y)) < sqrt (y) * (1 + y/6).
+     The other cases follow from acos (conj (z)) = conj (acos (z)) and
+     acos (-1 + i*y) = Pi - conj (acos (1 + i*y)). */
+{
+  mpfr_prec_t w = mpfr_get_prec (mpc_realref (z));
+  mpfr_t abs_y, s;
+  int inex, ok;
+
+  if (mpfr_get_exp (mpc_imagref (op)) > -w - 3)
+    return 0;
+
+  abs_y[0] = mpc_imagref (op)[0];
+  if (mpfr_signbit (abs_y))
+    MPFR_CHANGE_SIGN (abs_y);
+  mpfr_init2 (s, w);
+  inex = mpfr_sqrt (s, abs_y, MPFR_RNDN);
+  /* Since y/6 < 2^(-w-5), the real part and the absolute value of the
+     imaginary part of acos (1 + i*|y|) differ from s by less than 1 ulp.
+     If s = sqrt (|y|) is exact, they lie strictly between s and its
+     neighbour below, respectively above, and since w >= p_re + 2 and
+     w >= p_im + 2, these neighbours round as the exact values. */
+  if (inex == 0)
+    {
+      ok = 1;
+      mpfr_set (mpc_imagref (z), s, MPFR_RNDN);
+      mpfr_nextabove (mpc_imagref (z));
+      mpfr_nextbelow (s);
+    }
+  else
+    {
+      ok = mpfr_can_round (s, w - 1, MPFR_RNDN, MPFR_RNDZ,
+                           p_im + (MPC_RND_IM (rnd) == MPFR_RNDN));
+      mpfr_set (mpc_imagref (z), s, MPFR_RNDN);
+    }
+
+  if (ok)
+    {
+      if (mpfr_sgn (mpc_realref (op)) > 0)
+        {
+          mpfr_set (mpc_realref (z), s, MPFR_RNDN);
+          ok = inex == 0
+            || mpfr_can_round (s, w - 1, MPFR_RNDN, MPFR_RNDZ,
+                               p_re + (MPC_RND_RE (rnd) == MPFR_RNDN));
+        }
+      else
+        {
+          /* the error on o(Pi) - s is at most 1/2 ulp(Pi) + 1 ulp(s),
+             thus the error on its rounding is at most 2 ulps */
+          mpc_const_pi (mpc_realref (z), MPFR_RNDN);
+          mpfr_sub (mpc_realref (z), mpc_realref (z), s, MPFR_RNDN);
+          ok = mpfr_can_round (mpc_realref (z), w - 1, MPFR_RNDN, MPFR_RNDZ,
+                               p_re + (MPC_RND_RE (rnd) == MPFR_RNDN));
+        }
+    }
+
+  if (!mpfr_signbit (mpc_imagref (op)))
+    mpfr_neg (mpc_imagref (z), mpc_imagref (z), MPFR_RNDN);
+
+  mpfr_clear (s);
+
+  return ok;
+}
+
+static int
+acos_taylor1_square (mpfr_ptr re, mpfr_srcptr x, mpfr_srcptr y,
+                     mpfr_prec_t p_re, mpfr_rnd_t rnd_re)
+  /* Called from acos_taylor1 for x > 1 and y > 0 when the approximation
+     of Re (acos (x + i*y)) by T = y / sqrt (D), where D = x^2 - 1, cannot
+     be rounded. If D is the square of a rational number, put into re an
+     approximation of Re (acos (x + i*y)) from which the correctly rounded
+     value in precision p_re and its ternary value are obtained by
+     rounding in direction rnd_re, and return 1; otherwise T is irrational,
+     so that the failure is only due to a lack of precision, and return 0.
+     Since Re (acos (x + i*y)) = Im (acosh (x + i*y)) for y > 0 and the
+     derivatives of acosh at x are real, we have
+        Re (acos (x + i*y)) = T - c*T + tau
+     with c*T = acosh^(3) (x) * y^3 / 6 = (2x^2+1) * y^3 / (6 * D^(5/2)).
+     On the disk of radius r = (x-1)/2 around x, we have
+     |acosh' (z)| <= 2 / sqrt (D) and |acosh (z) - acosh (x)| < 1, so that
+     by Cauchy's inequalities |tau| <= 2 * (y/r)^5 if y <= r/2. The
+     conditions in acos_taylor1 imply y < 2^(-w-1) * (x-1), where w is the
+     precision of re, so that this holds and |tau| < c*T for w >= 5; and
+     c <= (x*y/D)^2 / 2 < 2^(-2w-5). So Re (acos (x + i*y)) lies in
+     (T - 2^(-2w-4) * T, T). */
+{
+  mpfr_prec_t w = mpfr_get_prec (re);
+  mpfr_t s;
+  int ok;
+
+  /* If D is the square of a rational number, it is the square of a
+     dyadic number, and x is not an integer; then D is exactly
+     representable with 2 * prec (x) bits, and so is its square root. */
+  if (mpfr_integer_p (x))
+    return 0;
+  mpfr_init2 (s, 2 * mpfr_get_prec (x));
+  mpfr_sqr (s, x, MPFR_RNDN);
+  mpfr_sub_ui (s, s, 1, MPFR_RNDN);
+  if (mpfr_sqrt (s, s, MPFR_RNDN) != 0)
+    {
+      mpfr_clear (s);
+      return 0;
+    }
+
+  if (mpfr_div (re, y, s, MPFR_RNDN) == 0)
+    {
+      /* Re (acos (x + i*y)) lies strictly between T and its neighbour
+         below, which round in the same way since w >= p_re + 2 */
+      mpfr_nextbelow (re);
+      ok = 1;
+    }
+  else
+    /* the error is bounded by 1/2 ulp + 2^(-2w-4) * T < 1 ulp */
+    ok = mpfr_can_round (re, w - 1, MPFR_RNDN, MPFR_RNDZ,
+                         p_re + (rnd_re == MPFR_RNDN));
+
+  mpfr_clear (s);
+
+  return ok;
+}
+
+static int
+acos_taylor1 (mpc_ptr z, mpc_srcptr op, mpfr_prec_t p_re,
+              mpfr_prec_t p_im, mpc_rnd_t rnd)
+  /* Assume op = x + i*y with x and y non-zero and |x| != 1, and let w be
+     the precision of both parts of z. If |y| is tiny with respect to
+     D = |1 - x^2|, put into z an approximation of acos (op) from which the
+     correctly rounded result in precision p_re + i*p_im and its ternary
+     value are obtained by rounding in direction rnd, and return 1;
+     otherwise return 0.
+     We use the Taylor expansion of order 1 at x, with the branch of acos
+     which is continuous on the side of y:
+        acos (x + i*y) = acos (x) - i*y / sqrt (1 - x^2) + R
+     with |R| <= y^2/2 * max |acos''|, where acos'' (z) = -z / (1-z^2)^(3/2)
+     is taken on the segment from x to x + i*y, on which |z| <= |x| + |y|.
+     For |x| < 1, we have |1 - z^2| >= D on this segment, so that
+     |R| <= y^2 / D^(3/2) as soon as |y| <= 1. Since acos (x) >= sqrt (D),
+        Re (acos (op)) = acos (x) * (1 + eta1),
+        Im (acos (op)) = -y / sqrt (D) * (1 + eta2),
+     with |eta1| <= y^2/D^2 and |eta2| <= |y|/D.
+     For |x| > 1, we have |1 - z^2| >= D/2 if y^2 <= D/2, so that
+     |R| <= 2^(3/2) * y^2 * |x| / D^(3/2); and since acosh (|x|) >=
+     sqrt (D) / |x|, if Im (op) > 0, then
+        Re (acos (op)) = |y| / sqrt (D) * (1 + eta1) for x > 1,
+        Re (acos (op)) = Pi - |y| / sqrt (D) * (1 + eta1) for x < -1,
+        Im (acos (op)) = -acosh (|x|) * (1 + eta2),
+     with |eta1| <= 2^(3/2) * |x*y| / D and |eta2| <= 2^(3/2) * (x*y/D)^2.
+     The case Im (op) < 0 follows from acos (conj (z)) = conj (acos (z)). */
+{
+  mpfr_prec_t w = mpfr_get_prec (mpc_realref (z));
+  mpfr_t abs_x, abs_y, a, d;
+  mpfr_exp_t ex, ey, ed;
+  int cmp, ok;
+
+  abs_x[0] = mpc_realref (op)[0];
+  if (mpfr_signbit (abs_x))
+    MPFR_CHANGE_SIGN (abs_x);
+  abs_y[0] = mpc_imagref (op)[0];
+  if (mpfr_signbit (abs_y))
+    MPFR_CHANGE_SIGN (abs_y);
+  ex = mpfr_get_exp (abs_x);
+  ey = mpfr_get_exp (abs_y);
+  cmp = mpfr_cmp_ui (abs_x, 1);
+
+  /* The conditions below imply ey <= -w - 1 if |x| < 1 and
+     ey <= ex - w - 4 if |x| > 1; discard quickly the other arguments, as
+     well as those for which x^2 might overflow. */
+  if ((cmp < 0 && ey > -w - 1) || (cmp > 0 && ey > ex - w - 4)
+      || ex >= mpfr_get_emax () / 2)
+    return 0;
+
+  /* d = o(o(|1 - |x||) * o(1 + |x|)) = D * (1 + theta)^3 with
+     |theta| <= 2^(-w), so that D >= 2^(ed-2) */
+  mpfr_init2 (a, w);
+  mpfr_init2 (d, w);
+  if (cmp < 0)
+    mpfr_ui_sub (a, 1, abs_x, MPFR_RNDN);
+  else
+    mpfr_sub_ui (a, abs_x, 1, MPFR_RNDN);
+  mpfr_add_ui (d, abs_x, 1, MPFR_RNDN);
+  mpfr_mul (d, d, a, MPFR_RNDN);
+  ed = mpfr_get_exp (d);
+
+  /* For |x| < 1, require |y| / D <= 2^(ey-ed+2) <= 2^(-w); then
+     |eta2| <= 2^(-w) and |eta1| <= 2^(-2w). For |x| > 1, require
+     2^(ey+ex-ed+4) <= 2^(-w), which implies y^2 <= D/2 and
+     |eta1| <= 2^(-w) and |eta2| <= 2^(-2w-2). */
+  if ((cmp < 0 && ey - ed + 2 > -w) || (cmp > 0 && ey + ex - ed + 4 > -w))
+    {
+      mpfr_clear (a);
+      mpfr_clear (d);
+      return 0;
+    }
+
+  /* a = |y| / sqrt (D) * (1 + theta') with |theta'| <= 2^(2-w); together
+     with eta1 or eta2, which is at most 2^(-w), the error on a as an
+     approximation of the corresponding part of the result is bounded by
+     2^(Exp (a) + 4 - w), and likewise for Pi - a when x < -1, which has
+     exponent 2. The remaining part is rounded to nearest from its
+     principal term, with an error bounded by 2^(Exp + 1 - w). */
+  mpfr_sqrt (d, d, MPFR_RNDN);
+  mpfr_div (a, abs_y, d, MPFR_RNDN);
+  if (cmp < 0)
+    {
+      mpfr_acos (mpc_realref (z), mpc_realref (op), MPFR_RNDN);
+      mpfr_set (mpc_imagref (z), a, MPFR_RNDN);
+      ok = mpfr_can_round (mpc_realref (z), w - 1, MPFR_RNDN, MPFR_RNDZ,
+                           p_re + (MPC_RND_RE (rnd) == MPFR_RNDN))
+        && mpfr_can_round (mpc_imagref (z), w - 4, MPFR_RNDN, MPFR_RNDZ,
+                           p_im + (MPC_RND_IM (rnd) == MPFR_RNDN));
+    }
+  else
+    {
+      mpfr_acosh (mpc_imagref (z), abs_x, MPFR_RNDN);
+      ok = mpfr_can_round (mpc_imagref (z), w - 1, MPFR_RNDN, MPFR_RNDZ,
+                           p_im + (MPC_RND_IM (rnd) == MPFR_RNDN));
+      if (mpfr_sgn (mpc_realref (op)) > 0)
+        {
+          mpfr_set (mpc_realref (z), a, MPFR_RNDN);
+          if (ok && !mpfr_can_round (mpc_realref (z), w - 4, MPFR_RNDN,
+                                     MPFR_RNDZ,
+                                     p_re + (MPC_RND_RE (rnd) == MPFR_RNDN)))
+            ok = acos_taylor1_square (mpc_realref (z), abs_x, abs_y,
+                                      p_re, MPC_RND_RE (rnd));
+        }
+      else
+        {
+          mpc_const_pi (mpc_realref (z), MPFR_RNDN);
+          mpfr_sub (mpc_realref (z), mpc_realref (z), a, MPFR_RNDN);
+          ok = ok && mpfr_can_round (mpc_realref (z), w - 4, MPFR_RNDN,
+                                     MPFR_RNDZ,
+                                     p_re + (MPC_RND_RE (rnd) == MPFR_RNDN));
+        }
+    }
+
+  if (!mpfr_signbit (mpc_imagref (op)))
+    mpfr_neg (mpc_imagref (z), mpc_imagref (z), MPFR_RNDN);
+
+  mpfr_clear (a);
+  mpfr_clear (d);
+
+  return ok;
+}
+
 int
 mpc_acos (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
 {
@@ -90,7 +351,7 @@ mpc_acos (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
                     {
                       p += mpc_ceil_log2 (p);
                       mpfr_set_prec (x, p);
-                      mpfr_const_pi (x, MPFR_RNDD);
+                      mpc_const_pi (x, MPFR_RNDD);
                       mpfr_mul_ui (x, x, 3, MPFR_RNDD);
                       ok =
                         mpfr_can_round (x, p - 1, MPFR_RNDD, MPC_RND_RE (rnd),
@@ -107,7 +368,7 @@ mpc_acos (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
               if (mpfr_sgn (mpc_realref (op)) > 0)
                 mpfr_set_ui (mpc_realref (rop), 0, MPFR_RNDN);
               else
-                inex_re = mpfr_const_pi (mpc_realref (rop), MPC_RND_RE (rnd));
+                inex_re = mpc_const_pi (mpc_realref (rop), MPC_RND_RE (rnd));
             }
         }
       else
@@ -147,7 +408,7 @@ mpc_acos (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
           else
             inex_im = -mpfr_acosh (mpc_imagref (rop), minus_op_re,
                                    INV_RND (MPC_RND_IM (rnd)));
-          inex_re = mpfr_const_pi (mpc_realref (rop), MPC_RND_RE (rnd));
+          inex_re = mpc_const_pi (mpc_realref (rop), MPC_RND_RE (rnd));
         }
       else
         {
@@ -177,9 +438,28 @@ mpc_acos (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
   mpfr_set_emin (mpfr_get_emin_min ());
   mpfr_set_emax (mpfr_get_emax_max ());
 
-  /* regular complex argument: acos(z) = Pi/2 - asin(z) */
   p_re = mpfr_get_prec (mpc_realref(rop));
   p_im = mpfr_get_prec (mpc_imagref(rop));
+
+  /* close to the real axis, use the expansion at the branch point 1 or -1,
+     or the Taylor expansion at the real part of op */
+  p = MPC_MAX (p_re, p_im);
+  p += mpc_ceil_log2 (p) + 6;
+  mpc_init2 (z1, p);
+  if (mpfr_cmp_ui (mpc_realref (op), 1) == 0
+      || mpfr_cmp_si (mpc_realref (op), -1) == 0
+      ? acos_branch_point (z1, op, p_re, p_im, rnd)
+      : acos_taylor1 (z1, op, p_re, p_im, rnd))
+    {
+      inex = mpc_set (rop, z1, rnd);
+      inex_re = MPC_INEX_RE(inex);
+      inex_im = MPC_INEX_IM(inex);
+      mpc_clear (z1);
+      goto end;
+    }
+  mpc_clear (z1);
+
+  /* regular complex argument: acos(z) = Pi/2 - asin(z) */
   p = p_re;
 
   /* when x/y is large (say 2^k), then the real part of asin(x+iy)
@@ -240,6 +520,7 @@ mpc_acos (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
   mpc_clear (z1);
   mpfr_clear (pi_over_2);
 
+ end:
   /* restore the exponent range, and check the range of results */
   mpfr_set_emin (saved_emin);
   mpfr_set_emax (saved_emax);
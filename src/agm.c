@@ -1,6 +1,6 @@
 /* mpc_agm -- AGM of a complex number.
 
-Copyright (C) 2022 INRIA
+Copyright (C) 2022, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -90,7 +90,7 @@ mpc_agm_general (mpc_ptr rop, mpc_srcptr a, mpc_srcptr b, mpc_rnd_t rnd)
       iteration. */
    mpc_init2 (b0, MPFR_PREC_MIN);
    mpc_init2 (a1, MPFR_PREC_MIN);
-   prec = 1;
+   prec = AGM_INITIAL_PREC / 2;
    do {
       prec *= 2;
       mpc_set_prec (b0, prec);
@@ -1,6 +1,6 @@
 /* mpc_asin -- arcsine of a complex number.
 
-Copyright (C) 2009, 2010, 2011, 2012, 2013, 2014, 2020, 2022, 2024 INRIA
+Copyright (C) 2009, 2010, 2011, 2012, 2013, 2014, 2020, 2022, 2024, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -39,7 +39,7 @@ mpc_asin_special (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd, mpc_ptr z1)
   if (ey >= 0 || ((-ey) / 2 < mpfr_get_prec (mpc_realref (z1))))
     return 0;
 
-  mpfr_const_pi (mpc_realref (z1), MPFR_RNDN);
+  mpc_const_pi (mpc_realref (z1), MPFR_RNDN);
   mpfr_div_2exp (mpc_realref (z1), mpc_realref (z1), 1, MPFR_RNDN); /* exact */
   p = mpfr_get_prec (mpc_realref (z1));
   /* if z1 has precision p, the error on z1 is 1/2*ulp(z1) = 2^(-p) so far,
@@ -550,14 +550,14 @@ mpc_asin (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
       break;
 
     /* try special code for small z */
-    if (mpfr_get_exp (mpc_realref (op)) <= -1 &&
-        mpfr_get_exp (mpc_imagref (op)) <= -1 &&
+    if (mpfr_get_exp (mpc_realref (op)) <= ASIN_SERIES_EXP &&
+        mpfr_get_exp (mpc_imagref (op)) <= ASIN_SERIES_EXP &&
         mpc_asin_series (rop, z1, op, rnd))
       break;
 
     /* try special code for large z and Im(z) > 0 */
-    if ((mpfr_get_exp (mpc_realref (op)) >= 2 ||
-         mpfr_get_exp (mpc_imagref (op)) >= 2) &&
+    if ((mpfr_get_exp (mpc_realref (op)) >= ASIN_LARGE_EXP ||
+         mpfr_get_exp (mpc_imagref (op)) >= ASIN_LARGE_EXP) &&
         mpfr_signbit (mpc_imagref (op)) == 0 &&
         mpc_asin_large_pos (rop, z1, op, rnd))
       break;
@@ -1,6 +1,6 @@
 /* mpc_atan -- arctangent of a complex number.
 
-Copyright (C) 2009, 2010, 2011, 2012, 2013, 2017, 2020, 2022, 2024 INRIA
+Copyright (C) 2009, 2010, 2011, 2012, 2013, 2017, 2020, 2022, 2024, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -31,7 +31,7 @@ set_pi_over_2 (mpfr_ptr rop, int s, mpfr_rnd_t rnd)
 {
   int inex;
 
-  inex = mpfr_const_pi (rop, s < 0 ? INV_RND (rnd) : rnd);
+  inex = mpc_const_pi (rop, s < 0 ? INV_RND (rnd) : rnd);
   mpfr_div_2ui (rop, rop, 1, MPFR_RNDN);
   if (s < 0)
     {
@@ -42,6 +42,88 @@ set_pi_over_2 (mpfr_ptr rop, int s, mpfr_rnd_t rnd)
   return inex;
 }
 
+/* Imaginary part of atan(x+i*y) for x regular and y > 0 tiny.
+   Let a = 1+x^2, T = y/a and w = y^2/a. Then
+   Im(atan(x+i*y)) = 1/2 atanh (u) with u = 2y/(a+y^2) = 2T/(1+w),
+   and atanh(u) = u + u^3/3 + ... with u^3/3 <= atanh(u) - u
+   <= u^3/(3*(1-u^2)); so
+   Im(atan(x+i*y)) = T * (1 + rho) with rho = T^2 * (1/3 - x^2 + theta)
+   where |theta| <= 12*y^2 for u^2 <= 1/2, and |rho| <= 2*y^2 for
+   |y| <= 1/4. The function assumes that 2*Exp(y) + prec + 4 <= 0, so
+   that |rho| < 2^(-prec-3).
+   First T is approximated by t = o(y/o(1+x^2)) with working precision
+   w, with an error of at most 5*2^-w*T, so that the total error is
+   bounded by 2^(max(3-w, 2*Exp(y)+1)+2+Exp(t)).
+   If this does not allow to round, T may be exactly a number of prec+1
+   bits; then its correct rounding is determined by the sign of rho,
+   which is the sign of 1-3*x^2 when |1-3*x^2| > 48*y^2.
+   The function returns 1 and sets v to a number which rounds to the
+   correct result with the correct ternary value in direction rnd to
+   precision prec; otherwise it returns 0. */
+static int
+atan_im_taylor (mpfr_ptr v, mpfr_srcptr x, mpfr_srcptr y, mpfr_prec_t prec,
+                mpfr_rnd_t rnd)
+{
+  mpfr_t c;
+  mpfr_prec_t w, pc;
+  mpfr_exp_t ex, ey, err;
+  int ok, inex;
+
+  ex = mpfr_get_exp (x);
+  ey = mpfr_get_exp (y);
+  w = prec + mpc_ceil_log2 (prec) + 4;
+  mpfr_set_prec (v, w);
+  mpc_tmp_fr_init2 (c, w);
+  mpfr_sqr (c, x, MPFR_RNDN);
+  mpfr_add_ui (c, c, 1, MPFR_RNDN);
+  mpfr_div (v, y, c, MPFR_RNDN);
+  ok = 0;
+  if (mpfr_regular_p (v) && mpfr_get_exp (v) >= mpfr_get_emin () + 2)
+    {
+      err = MPC_MAX (3 - (mpfr_exp_t) w, 2 * ey + 1) + 2;
+      ok = mpfr_can_round (v, -err, MPFR_RNDN, MPFR_RNDZ,
+                           prec + (rnd == MPFR_RNDN));
+
+      /* precision such that 1+x^2 and 3*x^2-1 are exact, provided it
+         is not too large */
+      pc = 0;
+      if (!ok && ex < 64
+          && ex > - (mpfr_exp_t) (prec + mpfr_get_prec (x)) - 64)
+        pc = MPC_MAX (2 * ex + 2, 1) + 1
+          - MPC_MIN (2 * (ex - (mpfr_exp_t) mpfr_get_prec (x)), 0);
+      if (pc != 0 && pc <= 4 * (prec + mpfr_get_prec (x)) + 256)
+        {
+          mpfr_set_prec (c, pc);
+          mpfr_sqr (c, x, MPFR_RNDN);
+          mpfr_add_ui (c, c, 1, MPFR_RNDN);
+          mpfr_set_prec (v, prec + 1);
+          inex = mpfr_div (v, y, c, MPFR_RNDN);
+          if (inex == 0)
+            {
+              /* T = v exactly; now c = 3*x^2-1 */
+              mpfr_sqr (c, x, MPFR_RNDN);
+              mpfr_mul_ui (c, c, 3, MPFR_RNDN);
+              mpfr_sub_ui (c, c, 1, MPFR_RNDN);
+              if (mpfr_get_exp (c) >= 2 * ey + 7)
+                {
+                  /* the result lies strictly between v and the
+                     neighbour of v with prec+2 bits in the direction of
+                     the sign of rho */
+                  ok = 1;
+                  mpfr_prec_round (v, prec + 2, MPFR_RNDN);
+                  if (mpfr_sgn (c) < 0)
+                    mpfr_nextabove (v);
+                  else
+                    mpfr_nextbelow (v);
+                }
+            }
+        }
+    }
+  mpc_tmp_fr_clear (c);
+
+  return ok;
+}
+
 int
 mpc_atan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
 {
@@ -226,11 +308,15 @@ mpc_atan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
     mpfr_exp_t err, expo;
     int loop;
     int ok = 0;
-    mpfr_t minus_op_re;
-    mpfr_exp_t op_re_exp, op_im_exp;
+    mpfr_t minus_op_re, abs_op_im;
+    mpfr_exp_t op_re_exp, op_im_exp, scale;
     mpfr_rnd_t rnd1, rnd2;
+    int im_underflow;
 
-    mpfr_inits2 (MPFR_PREC_MIN, a, b, x, y, (mpfr_ptr) 0);
+    mpc_tmp_fr_init2 (a, MPFR_PREC_MIN);
+    mpc_tmp_fr_init2 (b, MPFR_PREC_MIN);
+    mpc_tmp_fr_init2 (x, MPFR_PREC_MIN);
+    mpc_tmp_fr_init2 (y, MPFR_PREC_MIN);
 
     /* real part: Re(arctan(x+i*y)) = [arctan2(x,1-y) - arctan2(-x,1+y)]/2 */
     minus_op_re[0] = mpc_realref (op)[0];
@@ -256,6 +342,35 @@ mpc_atan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
        f = e/2            exact
     */
 
+    /* If |y| is tiny compared to |x|, then Re(atan(x+i*y)) is close to
+       atan(x): for 0 <= t <= 1, we have
+       |1+(x+i*t*y)^2|^2 = (1+x^2+t^2*y^2)^2 - 4*t^2*y^2
+                         >= (1+x^2)^2 * (1 - 4*y^2/(1+x^2)^2)
+                         >= (1+x^2)^2 * (1 - y^2/x^2),
+       so that for |y| <= |x|/2, |atan(x+i*y) - atan(x)| < 4/3*|y|/(1+x^2)
+       by the mean value theorem applied to atan' (z) = 1/(1+z^2). Since |atan(x)| >= |x|/(1+x^2), the
+       relative error of atan(x) as an approximation of the real part is
+       less than 4/3*|y/x| < 2^(Exp(y)-Exp(x)+2). Then
+       u = o(atan(x))    error(u) < [2^-p + 2^(Exp(y)-Exp(x)+2)]*(1+2^-p)*2^Exp(u)
+                                  < 2^(max(-p,Exp(y)-Exp(x)+2)+2+Exp(u)) */
+    ok = 0;
+    if (op_re_exp - op_im_exp > (mpfr_exp_t) prec + 4)
+      {
+        p = prec + mpc_ceil_log2 (prec) + 4;
+        while (1)
+          {
+            mpfr_set_prec (x, p);
+            mpfr_atan (x, mpc_realref (op), MPFR_RNDN);
+            err = MPC_MAX (- (mpfr_exp_t) p, op_im_exp - op_re_exp + 2) + 2;
+            ok = mpfr_can_round (x, -err, MPFR_RNDN, MPFR_RNDZ,
+                                 prec + (MPC_RND_RE (rnd) == MPFR_RNDN));
+            /* stop when y is not negligible any more */
+            if (ok || op_re_exp - op_im_exp - 2 <= (mpfr_exp_t) p)
+              break;
+            p += p / 2;
+          }
+      }
+
     /* p: working precision */
     p = (op_im_exp > 0 || prec > SAFE_ABS (mpfr_prec_t, op_im_exp)) ? prec
       : (prec - op_im_exp);
@@ -263,7 +378,7 @@ mpc_atan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
     rnd2 = mpfr_sgn (mpc_realref (op)) < 0 ? MPFR_RNDU : MPFR_RNDD;
 
     loop = 0;
-    do
+    while (ok == 0)
       {
         MPC_LOOP_NEXT(loop, op, rop);
         p += (loop <= 2) ? mpc_ceil_log2 (p) + 2 : p / 2;
@@ -314,97 +429,102 @@ mpc_atan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
            on prec + ... bits, mpfr_can_round will return 0 */
         ok = mpfr_can_round (x, p - err, MPFR_RNDU, MPFR_RNDD,
                              prec + (MPC_RND_RE (rnd) == MPFR_RNDN));
-      } while (ok == 0);
+      }
 
     /* Imaginary part
-       Im(atan(x+I*y)) = 1/4 * [log(x^2+(1+y)^2) - log (x^2 +(1-y)^2)] */
+       Im(atan(x+I*y)) = 1/4 * log1p (4*y / (x^2 + (1-y)^2)),
+       which is an odd function of y; we compute it for |y|, so that the
+       argument q of log1p is positive and there is no cancellation.
+       All operations are rounded to nearest with working precision p,
+       thus with a relative error of at most eps = 2^-p:
+       f = o(1-|y|)
+       g = o(f^2)       relative error(g) <= (1+eps)^3 - 1
+       c = o(x^2)
+       h = o(c+g)       relative error(h) <= (1+eps)^4 - 1 since c, g >= 0
+       q = o(4*|y|/h)   |q - q0| <= 10 eps q0 where q0 = 4*|y|/(x^2+(1-y)^2)
+       l = o(log1p(q))  since log1p'(t) = 1/(1+t) and log1p(q0) >= q0/(1+q0),
+                        the error on q yields a relative error of at most
+                        10 eps/(1-10 eps) on log1p(q), so the relative error
+                        of l is at most 13 eps.
+       If q < 2^-p, we use q instead of log1p(q), which is the first term of
+       its Taylor series and adds a relative error of at most
+       (q/2)/(1-q/2) < eps, so the relative error of l is at most 14 eps.
+       Then error(l) <= 14 eps (1+14 eps) 2^Exp(l) < 2^4 ulp(l), and the
+       division by 4 is exact.
+       If x^2+(1-y)^2 overflows, f and x are first scaled by 2^-scale. */
     prec = mpfr_get_prec (mpc_imagref (rop)); /* result precision */
-
-    /* a = o(1+y)    error(a) < 1 ulp(a)
-       b = o(a^2)    error(b) < 5 ulp(b)
-       c = o(x^2)    error(c) < 1 ulp(c)
-       d = o(b+c)    error(d) < 7 ulp(d)
-       e = o(log(d)) error(e) < [1 + 7*2^{2-Exp(e)}] ulp(e) = ke ulp(e)
-       f = o(1-y)    error(f) < 1 ulp(f)
-       g = o(f^2)    error(g) < 5 ulp(g)
-       h = o(c+f)    error(h) < 7 ulp(h)
-       i = o(log(h)) error(i) < [1 + 7*2^{2-Exp(i)}] ulp(i) = ki ulp(i)
-       j = o(e-i)    error(j) < [1 + ke*2^{Exp(e)-Exp(j)}
-                                   + ki*2^{Exp(i)-Exp(j)}] ulp(j)
-                     error(j) < [1 + 2^{Exp(e)-Exp(j)} + 2^{Exp(i)-Exp(j)}
-                                   + 7*2^{3-Exp(j)}] ulp(j)
-                              < [1 + 2^{max(Exp(e),Exp(i))-Exp(j)+1}
-                                   + 7*2^{3-Exp(j)}] ulp(j)
-       k = j/4       exact
-    */
-    err = 2;
-    p = prec; /* working precision */
-
-    do
+    abs_op_im[0] = mpc_imagref (op)[0];
+    if (s_im)
+      MPFR_CHANGE_SIGN (abs_op_im);
+    im_underflow = 0;
+    p = prec + mpc_ceil_log2 (prec) + 6; /* working precision */
+
+    ok = 2 * op_im_exp + (mpfr_exp_t) prec + 4 <= 0
+      && atan_im_taylor (y, mpc_realref (op), abs_op_im, prec,
+                         MPC_RND_IM (rnd));
+    while (ok == 0)
       {
-        p += mpc_ceil_log2 (p) + err;
         mpfr_set_prec (a, p);
         mpfr_set_prec (b, p);
         mpfr_set_prec (y, p);
 
-        /* a = upper bound for log(x^2 + (1+y)^2) */
-        mpfr_add_ui (a, mpc_imagref (op), 1, MPFR_RNDA);
-        mpfr_sqr (a, a, MPFR_RNDU);
-        mpfr_sqr (y, mpc_realref (op), MPFR_RNDU);
-        mpfr_add (a, a, y, MPFR_RNDU);
-        mpfr_log (a, a, MPFR_RNDU);
-
-        /* b = lower bound for log(x^2 + (1-y)^2) */
-        mpfr_ui_sub (b, 1, mpc_imagref (op), MPFR_RNDZ); /* round to zero */
-        mpfr_sqr (b, b, MPFR_RNDZ);
-        /* we could write mpfr_sqr (y, mpc_realref (op), MPFR_RNDZ) but it is
-           more efficient to reuse the value of y (x^2) above and subtract
-           one ulp */
-        mpfr_nextbelow (y);
-        mpfr_add (b, b, y, MPFR_RNDZ);
-        mpfr_log (b, b, MPFR_RNDZ);
-
-        mpfr_sub (y, a, b, MPFR_RNDU);
-
-        if (mpfr_zero_p (y))
-           /* FIXME: happens when x and y have very different magnitudes;
-              could be handled more efficiently                           */
-          ok = 0;
-        else
+        mpfr_ui_sub (a, 1, abs_op_im, MPFR_RNDN);
+        mpfr_sqr (b, mpc_realref (op), MPFR_RNDN);
+        mpfr_sqr (y, a, MPFR_RNDN);
+        mpfr_add (b, b, y, MPFR_RNDN);
+        scale = 0;
+        if (mpfr_inf_p (b))
+          {
+            scale = mpfr_zero_p (a) ? op_re_exp
+              : MPC_MAX (op_re_exp, mpfr_get_exp (a));
+            mpfr_mul_2si (a, a, -scale, MPFR_RNDN);
+            mpfr_set_prec (b, mpfr_get_prec (mpc_realref (op)));
+            mpfr_mul_2si (b, mpc_realref (op), -scale, MPFR_RNDN);
+            mpfr_sqr (y, b, MPFR_RNDN);
+            mpfr_set_prec (b, p);
+            mpfr_sqr (b, a, MPFR_RNDN);
+            mpfr_add (b, b, y, MPFR_RNDN);
+          }
+        mpfr_div (y, abs_op_im, b, MPFR_RNDN);
+        mpfr_mul_2si (y, y, 2 - 2 * scale, MPFR_RNDN);
+
+        if (mpfr_zero_p (y) || mpfr_get_exp (y) < mpfr_get_emin () + 2)
           {
-            expo = MPC_MAX (mpfr_get_exp (a), mpfr_get_exp (b));
-            expo = expo - mpfr_get_exp (y) + 1;
-            err = 3 - mpfr_get_exp (y);
-            /* error(j) <= [1 + 2^expo + 7*2^err] ulp(j) */
-            if (expo <= err) /* error(j) <= [1 + 2^{err+1}] ulp(j) */
-              err = (err < 0) ? 1 : err + 2;
-            else
-              err = (expo < 0) ? 1 : expo + 2;
-
-            mpfr_div_2ui (y, y, 2, MPFR_RNDN);
-            MPC_ASSERT (!mpfr_zero_p (y));
-               /* FIXME: underflow. Since the main term of the Taylor series
-                  in y=0 is 1/(x^2+1) * y, this means that y is very small
-                  and/or x very large; but then the mpfr_zero_p (y) above
-                  should be true. This needs a proof, or better yet,
-                  special code.                                              */
-
-            ok = mpfr_can_round (y, p - err, MPFR_RNDU, MPFR_RNDD,
-                                 prec + (MPC_RND_IM (rnd) == MPFR_RNDN));
+            /* the imaginary part is less than 2^(emin-1) in absolute
+               value, even in the extended exponent range */
+            im_underflow = 1;
+            mpfr_set_zero (y, +1);
+            break;
           }
-      } while (ok == 0);
+        if (mpfr_get_exp (y) > - (mpfr_exp_t) p)
+          mpfr_log1p (y, y, MPFR_RNDN);
+        mpfr_div_2ui (y, y, 2, MPFR_RNDN);
+
+        ok = mpfr_can_round (y, p - 4, MPFR_RNDN, MPFR_RNDZ,
+                             prec + (MPC_RND_IM (rnd) == MPFR_RNDN));
+        if (ok == 0)
+          p += p / 2;
+      }
+    if (s_im)
+      MPFR_CHANGE_SIGN (y);
 
     inex = mpc_set_fr_fr (rop, x, y, rnd);
 
-    mpfr_clears (a, b, x, y, (mpfr_ptr) 0);
+    mpc_tmp_fr_clear (y);
+    mpc_tmp_fr_clear (x);
+    mpc_tmp_fr_clear (b);
+    mpc_tmp_fr_clear (a);
 
     /* restore the exponent range, and check the range of results */
     mpfr_set_emin (saved_emin);
     mpfr_set_emax (saved_emax);
     inex_re = mpfr_check_range (mpc_realref (rop), MPC_INEX_RE (inex),
                                 MPC_RND_RE (rnd));
-    inex_im = mpfr_check_range (mpc_imagref (rop), MPC_INEX_IM (inex),
-                                MPC_RND_IM (rnd));
+    if (im_underflow)
+      inex_im = mpc_fix_zero (mpc_imagref (rop), MPC_RND_IM (rnd));
+    else
+      inex_im = mpfr_check_range (mpc_imagref (rop), MPC_INEX_IM (inex),
+                                  MPC_RND_IM (rnd));
 
     return MPC_INEX (inex_re, inex_im);
   }
@@ -0,0 +1,83 @@
+/* mpc_cis -- exponential of i times a real number.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* Convert the part of the return value of mpfr_sin_cos encoded on two bits
+   into a ternary value: 0 if exact, 1 if the result is larger than the
+   exact value and 2 if it is smaller. */
+#define SIN_COS_INEX(i) ((i) == 0 ? 0 : ((i) == 1 ? 1 : -1))
+
+int
+mpc_cis (mpc_ptr rop, mpfr_srcptr x, mpc_rnd_t rnd)
+{
+   mpfr_t s, c, xx;
+   mpfr_prec_t prec;
+   int inex, inex_re, inex_im;
+
+   if (x == mpc_realref (rop) || x == mpc_imagref (rop)) {
+      mpfr_init2 (xx, mpfr_get_prec (x));
+      mpfr_set (xx, x, MPFR_RNDN);
+      inex = mpc_cis (rop, xx, rnd);
+      mpfr_clear (xx);
+      return inex;
+   }
+
+   if (MPC_RND_RE (rnd) == MPC_RND_IM (rnd)) {
+      /* both parts are correctly rounded by a single call; this also
+         covers x = NaN or infinite, where both parts are NaN, and x = 0,
+         where the result 1 + i*x is exact */
+      inex = mpfr_sin_cos (mpc_imagref (rop), mpc_realref (rop), x,
+                           MPC_RND_RE (rnd));
+      inex_im = SIN_COS_INEX (inex & 3);
+      inex_re = SIN_COS_INEX ((inex >> 2) & 3);
+      return MPC_INEX (inex_re, inex_im);
+   }
+
+   if (!mpfr_number_p (x) || mpfr_zero_p (x)) {
+      mpfr_sin_cos (mpc_imagref (rop), mpc_realref (rop), x, MPFR_RNDN);
+      return MPC_INEX (0, 0);
+   }
+
+   /* Otherwise the parts are rounded in different directions, and
+      mpfr_sin_cos is called with rounding to nearest at a working
+      precision, with an error of at most 1/2 ulp on each part. Both
+      parts are irrational for x != 0, so that the loop terminates. */
+   prec = MPC_MAX_PREC (rop) + 20;
+   mpc_tmp_fr_init2 (s, prec);
+   mpc_tmp_fr_init2 (c, prec);
+   for (;;) {
+      mpfr_sin_cos (s, c, x, MPFR_RNDN);
+      if (mpfr_can_round (c, prec, MPFR_RNDN, MPFR_RNDZ,
+                          MPC_PREC_RE (rop) + (MPC_RND_RE (rnd) == MPFR_RNDN))
+          && mpfr_can_round (s, prec, MPFR_RNDN, MPFR_RNDZ,
+                          MPC_PREC_IM (rop) + (MPC_RND_IM (rnd) == MPFR_RNDN)))
+         break;
+      prec += prec / 2;
+      mpfr_set_prec (s, prec);
+      mpfr_set_prec (c, prec);
+   }
+   inex_re = mpfr_set (mpc_realref (rop), c, MPC_RND_RE (rnd));
+   inex_im = mpfr_set (mpc_imagref (rop), s, MPC_RND_IM (rnd));
+   mpc_tmp_fr_clear (c);
+   mpc_tmp_fr_clear (s);
+
+   return MPC_INEX (inex_re, inex_im);
+}
@@ -0,0 +1,143 @@
+/* mpc_const_pi, mpc_const_log2, mpc_const_log10, mpc_const_sqrt3,
+   mpc_const_log_base, mpc_free_cache -- Cached mathematical constants.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+#define CONST_PI    0
+#define CONST_LOG2  1
+#define CONST_LOG10 2
+#define CONST_SQRT3 3
+#define CONST_NUM   4
+
+#ifdef HAVE_THREAD_LOCAL
+/* The constants rounded to nearest at the largest precision computed so
+   far in the current thread; a precision of 0 means that the constant
+   has not been computed yet. Without thread local storage, the cache
+   would be shared by all threads, so that the constants are computed
+   at each call. */
+static MPC_THREAD_ATTR mpfr_t const_cache [CONST_NUM];
+static MPC_THREAD_ATTR mpfr_prec_t const_prec [CONST_NUM];
+#endif
+
+static int
+const_compute (mpfr_ptr rop, int c, mpfr_rnd_t rnd)
+{
+   switch (c) {
+   case CONST_PI:
+      return mpfr_const_pi (rop, rnd);
+   case CONST_LOG2:
+      return mpfr_const_log2 (rop, rnd);
+   case CONST_LOG10:
+      return mpfr_log_ui (rop, 10, rnd);
+   default:
+      return mpfr_sqrt_ui (rop, 3, rnd);
+   }
+}
+
+static int
+const_get (mpfr_ptr rop, int c, mpfr_rnd_t rnd)
+   /* Set rop to the constant c correctly rounded in the direction rnd,
+      and return the ternary value. All constants are irrational, so
+      that the loop terminates; it is left at the first iteration unless
+      the precision of rop is close to or larger than that of the cache,
+      which then grows geometrically. */
+{
+#ifdef HAVE_THREAD_LOCAL
+   mpfr_ptr x = const_cache [c];
+   mpfr_prec_t p = mpfr_get_prec (rop), prec;
+   mpfr_exp_t saved_emin, saved_emax;
+
+   /* the constants lie in [0.5, 4), so that the exponent range matters
+      only in the unlikely case that it has been reduced to exclude them */
+   saved_emin = mpfr_get_emin ();
+   saved_emax = mpfr_get_emax ();
+   mpfr_set_emin (mpfr_get_emin_min ());
+   mpfr_set_emax (mpfr_get_emax_max ());
+
+   /* the cached value has an error of at most 1/2 ulp */
+   while (const_prec [c] == 0
+          || !mpfr_can_round (x, const_prec [c], MPFR_RNDN, MPFR_RNDZ,
+                              p + (rnd == MPFR_RNDN))) {
+      prec = MPC_MAX (const_prec [c] + const_prec [c] / 2,
+                      p + mpc_ceil_log2 (p) + 10);
+      if (const_prec [c] == 0)
+         mpfr_init2 (x, prec);
+      else
+         mpfr_set_prec (x, prec);
+      const_compute (x, c, MPFR_RNDN);
+      const_prec [c] = prec;
+   }
+
+   mpfr_set_emin (saved_emin);
+   mpfr_set_emax (saved_emax);
+   return mpfr_set (rop, x, rnd);
+#else
+   return const_compute (rop, c, rnd);
+#endif
+}
+
+int
+mpc_const_pi (mpfr_ptr rop, mpfr_rnd_t rnd)
+{
+   return const_get (rop, CONST_PI, rnd);
+}
+
+int
+mpc_const_log2 (mpfr_ptr rop, mpfr_rnd_t rnd)
+{
+   return const_get (rop, CONST_LOG2, rnd);
+}
+
+int
+mpc_const_log10 (mpfr_ptr rop, mpfr_rnd_t rnd)
+{
+   return const_get (rop, CONST_LOG10, rnd);
+}
+
+int
+mpc_const_sqrt3 (mpfr_ptr rop, mpfr_rnd_t rnd)
+{
+   return const_get (rop, CONST_SQRT3, rnd);
+}
+
+void
+mpc_const_log_base (mpfr_ptr rop, int base)
+   /* Set rop to log(base) for base 2 or 10, rounded to nearest. */
+{
+   if (base == 2)
+      mpc_const_log2 (rop, MPFR_RNDN);
+   else
+      mpc_const_log10 (rop, MPFR_RNDN);
+}
+
+void
+mpc_free_cache (void)
+{
+#ifdef HAVE_THREAD_LOCAL
+   int c;
+
+   for (c = 0; c < CONST_NUM; c++)
+      if (const_prec [c] != 0) {
+         mpfr_clear (const_cache [c]);
+         const_prec [c] = 0;
+      }
+#endif
+}
@@ -0,0 +1,812 @@
+/* dd -- Fast paths in double-double arithmetic for small precisions.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <float.h>
+#include <math.h>
+#include "mpc-impl.h"
+
+/* The functions mpc_xxx_dd of this file try to compute the result of
+   mpc_xxx for target precisions of at most DD_MAX_PREC bits and arguments
+   of at most 106 bits in double-double arithmetic, which is much faster
+   than MPFR at these precisions. Every double-double number carries an
+   upper bound on its absolute error, propagated through all operations,
+   so that mpfr_can_round decides rigorously whether the approximation
+   determines the correctly rounded result. If so, the functions store it
+   in rop, the ternary value in *inex and return 1; otherwise, or if the
+   arguments are outside the range in which the computations neither
+   underflow nor overflow, they return 0 without changing rop, and the
+   caller falls back to the generic algorithm.
+   Double-double arithmetic relies on double operations being correctly
+   rounded to 53 bits; when this cannot be ascertained at compile time,
+   in particular on platforms evaluating in extended precision, the fast
+   paths are disabled. */
+
+#if defined (FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0 \
+    && FLT_RADIX == 2 && DBL_MANT_DIG == 53
+#define MPC_USE_DD 1
+#else
+#define MPC_USE_DD 0
+#endif
+
+/* precision of the temporary variables holding the approximations */
+#define DD_TMP_PREC 128
+
+/* arguments are limited to the range [2^-DD_EXP_MAX, 2^DD_EXP_MAX] in
+   absolute value, so that no intermediate result or error bound becomes
+   subnormal or infinite */
+#define DD_EXP_MAX 256
+
+/* the first order approximations of logarithms are refined only if
+   their relative error is at most 2^(-20) */
+#define DD_NEWTON_MAX (1.0 / 1048576)
+
+/* 2^(-53), the unit roundoff */
+#define DD_U (DBL_EPSILON / 2)
+
+/* error bounds are computed in rounding to nearest with a handful of
+   operations; multiplying by this factor turns them into upper bounds */
+#define DD_UP(x) ((x) * (1 + 8 * DBL_EPSILON))
+
+/* ln(2) and pi/2 as the sum of three doubles, the first one having 31
+   significant bits, with a bound on the remaining error */
+#define LN2_1 0.69314718060195446
+#define LN2_2 -4.2009150726810846e-11
+#define LN2_3 -1.3124698417785255e-27
+#define LN2_ERR 4e-44
+#define INV_LN2 1.4426950408889634
+#define PIO2_1 1.5707963267341256
+#define PIO2_2 6.0771005065061922e-11
+#define PIO2_3 3.5215598651832002e-27
+#define PIO2_ERR 3e-43
+#define TWO_OVER_PI 0.63661977236758138
+
+/* 1/ln(2) and 1/ln(10) as double-double numbers */
+static const double inv_ln2 [2] =
+   { 1.4426950408889634, 2.0355273740931033e-17 };
+static const double inv_ln10 [2] =
+   { 0.43429448190325182, 1.0983196502167651e-17 };
+
+/* 1/n! for 0 <= n <= 20 as double-double numbers */
+static const double inv_fact [21][2] = {
+   { 1, 0 },
+   { 1, 0 },
+   { 0.5, 0 },
+   { 0.16666666666666666, 9.2518585385429707e-18 },
+   { 0.041666666666666664, 2.3129646346357427e-18 },
+   { 0.0083333333333333332, 1.1564823173178714e-19 },
+   { 0.0013888888888888889, -5.3005439543735771e-20 },
+   { 0.00019841269841269841, 1.7209558293420705e-22 },
+   { 2.4801587301587302e-05, 2.1511947866775882e-23 },
+   { 2.7557319223985893e-06, -1.8583932740464721e-22 },
+   { 2.7557319223985888e-07, 2.3767714622250297e-23 },
+   { 2.505210838544172e-08, -1.448814070935912e-24 },
+   { 2.08767569878681e-09, -1.20734505911326e-25 },
+   { 1.6059043836821613e-10, 1.2585294588752098e-26 },
+   { 1.1470745597729725e-11, 2.0655512752830745e-28 },
+   { 7.6471637318198164e-13, 7.03872877733453e-30 },
+   { 4.7794773323873853e-14, 4.3992054858340813e-31 },
+   { 2.8114572543455206e-15, 1.6508842730861433e-31 },
+   { 1.5619206968586225e-16, 1.1910679660273754e-32 },
+   { 8.2206352466243295e-18, 2.2141894119604265e-34 },
+   { 4.1103176233121648e-19, 1.4412973378659527e-36 }
+};
+
+/* A double-double number: the approximation hi+lo, with |lo| at most
+   half an ulp of hi, of some real number, and a bound err on the
+   absolute error of the approximation. */
+typedef struct {
+   double hi, lo, err;
+} dd_t;
+
+
+/*
+ * Error free transformations
+ */
+
+static void two_sum (double *s, double *e, double a, double b)
+   /* Set s to the rounded sum of a and b and e to its error, so that
+      a+b = s+e exactly. */
+{
+   double t;
+
+   *s = a + b;
+   t = *s - a;
+   *e = (a - (*s - t)) + (b - t);
+}
+
+
+static void two_prod (double *p, double *e, double a, double b)
+   /* Set p to the rounded product of a and b and e to its error, so that
+      a*b = p+e exactly, provided that no underflow or overflow occurs. */
+{
+#ifdef FP_FAST_FMA
+   *p = a * b;
+   *e = fma (a, b, -*p);
+#else
+   /* Dekker's algorithm; all the products of halves are exact, so that
+      the result does not depend on contractions into fma */
+   const double split = 134217729.0; /* 2^27+1 */
+   double t, ah, al, bh, bl;
+
+   t = split * a;
+   ah = t - (t - a);
+   al = a - ah;
+   t = split * b;
+   bh = t - (t - b);
+   bl = b - bh;
+   *p = a * b;
+   *e = ((ah * bh - *p) + ah * bl + al * bh) + al * bl;
+#endif
+}
+
+
+/*
+ * Double-double arithmetic with error bounds
+ */
+
+static dd_t dd_d (double x)
+   /* Return x as an exact double-double number. */
+{
+   dd_t r;
+
+   r.hi = x;
+   r.lo = 0;
+   r.err = 0;
+   return r;
+}
+
+
+static dd_t dd_const (const double *c)
+   /* Return the double-double constant c, which is correctly rounded to
+      106 bits, so that its error is bounded by 2^(-106) |c|. */
+{
+   dd_t r;
+
+   r.hi = c [0];
+   r.lo = c [1];
+   r.err = fabs (c [0]) * (DD_U * DBL_EPSILON);
+   return r;
+}
+
+
+static double dd_abs (dd_t x)
+   /* Return an upper bound on the absolute value of the exact number
+      approximated by x. */
+{
+   return DD_UP (fabs (x.hi) + fabs (x.lo) + x.err);
+}
+
+
+static dd_t dd_neg (dd_t x)
+{
+   x.hi = -x.hi;
+   x.lo = -x.lo;
+   return x;
+}
+
+
+static dd_t dd_mul_2si (dd_t x, int k)
+   /* Return x*2^k, assuming that no underflow or overflow occurs. */
+{
+   x.hi = ldexp (x.hi, k);
+   x.lo = ldexp (x.lo, k);
+   x.err = ldexp (x.err, k);
+   return x;
+}
+
+
+static dd_t dd_add (dd_t x, dd_t y)
+   /* Return x+y; the two roundings in the algorithm are computed exactly
+      and added to the error, so that exact sums are recognised. */
+{
+   dd_t r;
+   double s1, s2, t1, t2, e1, e2;
+
+   two_sum (&s1, &s2, x.hi, y.hi);
+   two_sum (&t1, &t2, x.lo, y.lo);
+   two_sum (&s2, &e1, s2, t1);
+   two_sum (&s1, &s2, s1, s2);
+   two_sum (&s2, &e2, s2, t2);
+   two_sum (&r.hi, &r.lo, s1, s2);
+   r.err = DD_UP (x.err + y.err + (fabs (e1) + fabs (e2)));
+   return r;
+}
+
+
+static dd_t dd_sub (dd_t x, dd_t y)
+{
+   return dd_add (x, dd_neg (y));
+}
+
+
+static dd_t dd_mul (dd_t x, dd_t y)
+   /* Return x*y; the product of two doubles is exact. */
+{
+   dd_t r;
+   double p, e, a, b, rnd;
+
+   two_prod (&p, &e, x.hi, y.hi);
+   if (x.lo == 0 && y.lo == 0)
+      rnd = 0;
+   else {
+      /* the neglected product x.lo*y.lo and the roundings of a, b,
+         a+b and e */
+      a = x.hi * y.lo;
+      b = x.lo * y.hi;
+      e += a + b;
+      rnd = fabs (x.lo * y.lo) + 2 * DD_U * (fabs (a) + fabs (b))
+            + DD_U * fabs (e);
+   }
+   two_sum (&r.hi, &r.lo, p, e);
+   r.err = DD_UP (  (fabs (x.hi) + fabs (x.lo)) * y.err
+                  + (fabs (y.hi) + fabs (y.lo)) * x.err
+                  + x.err * y.err + rnd);
+   return r;
+}
+
+
+static dd_t dd_div (dd_t x, dd_t y)
+   /* Return x/y; the rounding error is bounded a posteriori by the
+      residual x-q*y, computed from the exact values of x and y. */
+{
+   dd_t q, xe, ye, res;
+   double den, rnd;
+
+   den = (fabs (y.hi) - fabs (y.lo) - y.err) * (1 - 8 * DBL_EPSILON);
+   if (!(den > 0)) {
+      q.hi = q.lo = 0;
+      q.err = DBL_MAX;
+      return q;
+   }
+
+   xe = x;
+   xe.err = 0;
+   ye = y;
+   ye.err = 0;
+   q = dd_d (x.hi / y.hi);
+   res = dd_sub (xe, dd_mul (q, ye));
+   q = dd_add (q, dd_d (res.hi / y.hi));
+   q.err = 0;
+   res = dd_sub (xe, dd_mul (q, ye));
+   rnd = dd_abs (res) / den;
+
+   /* |x/y - x~/y~| <= (err(x) + |x~/y~|*err(y)) / (|y~| - err(y)) */
+   q.err = DD_UP (rnd + (x.err + (dd_abs (q) + rnd) * y.err) / den);
+   return q;
+}
+
+
+static dd_t dd_sqrt (dd_t x)
+   /* Return sqrt(x) for x > 0; the rounding error is bounded a posteriori
+      by the residual x-q^2, as for the division. */
+{
+   dd_t q, xe, res;
+   double den;
+
+   den = (fabs (x.hi) - fabs (x.lo) - x.err) * (1 - 8 * DBL_EPSILON);
+   if (!(den > 0)) {
+      q.hi = q.lo = 0;
+      q.err = DBL_MAX;
+      return q;
+   }
+   /* a lower bound on the square roots of x and of its approximation */
+   den = sqrt (den) * (1 - 8 * DBL_EPSILON);
+
+   xe = x;
+   xe.err = 0;
+   q = dd_d (sqrt (x.hi));
+   res = dd_sub (xe, dd_mul (q, q));
+   q = dd_add (q, dd_d (res.hi / (2 * q.hi)));
+   q.err = 0;
+   res = dd_sub (xe, dd_mul (q, q));
+
+   /* |sqrt(x) - q| <= |sqrt(x) - sqrt(x~)| + |x~ - q^2| / (sqrt(x~) + q)
+                    <= (err(x) + |x~ - q^2|) / den */
+   q.err = DD_UP ((x.err + dd_abs (res)) / den);
+   return q;
+}
+
+
+/*
+ * Elementary functions
+ */
+
+static long dd_nearest (double x)
+   /* Return an integer close to x, which is at most 2^62 in absolute
+      value. */
+{
+   return (long) (x < 0 ? x - 0.5 : x + 0.5);
+}
+
+
+static dd_t dd_reduce (dd_t x, long k, double c1, double c2, double c3,
+   double cerr)
+   /* Return x - k*c with c = c1+c2+c3 up to cerr, where k*c1 is exact. */
+{
+   dd_t r, p;
+   double kd = (double) k;
+
+   r = dd_sub (x, dd_d (kd * c1));
+   two_prod (&p.hi, &p.lo, kd, c2);
+   p.err = 0;
+   r = dd_sub (r, p);
+   two_prod (&p.hi, &p.lo, kd, c3);
+   r = dd_sub (r, p);
+   r.err = DD_UP (r.err + fabs (kd) * cerr);
+   return r;
+}
+
+
+static dd_t dd_exp (dd_t x, long *k)
+   /* Return expm1 (x - k*log(2)) for the integer k closest to x/log(2),
+      which is returned in *k, so that exp(x) = 2^k * (1 + result).
+      Assumes |x| < 2^20. */
+{
+   dd_t r, s, e;
+   double a, t;
+   int n;
+
+   *k = dd_nearest (x.hi * INV_LN2);
+   r = dd_reduce (x, *k, LN2_1, LN2_2, LN2_3, LN2_ERR);
+
+   /* |r| <= log(2)/2, thus |s| < 2^(-9) */
+   s = dd_mul_2si (r, -8);
+
+   /* Taylor series up to degree 9; the remainder is at most
+      2 |s|^10/10! since |s| < 1/2 */
+   e = dd_const (inv_fact [9]);
+   for (n = 8; n >= 1; n--)
+      e = dd_add (dd_mul (e, s), dd_const (inv_fact [n]));
+   e = dd_mul (e, s);
+   a = fabs (s.hi) + fabs (s.lo);
+   t = a * a;
+   t = t * t;
+   t = t * t * a * a;
+   e.err = DD_UP (e.err + 2 * t * inv_fact [10][0]);
+
+   /* expm1 (2y) = expm1 (y) * (2 + expm1 (y)) */
+   for (n = 0; n < 8; n++)
+      e = dd_add (dd_mul_2si (e, 1), dd_mul (e, e));
+
+   return e;
+}
+
+
+static void dd_sin_cos (dd_t *s, dd_t *c, dd_t x)
+   /* Set s and c to sin(x) and cos(x). Assumes |x| < 2^20. */
+{
+   dd_t r, t, z, sr, vr, tmp;
+   double a, b;
+   long k;
+   int n;
+
+   k = dd_nearest (x.hi * TWO_OVER_PI);
+   r = dd_reduce (x, k, PIO2_1, PIO2_2, PIO2_3, PIO2_ERR);
+
+   /* |r| <= pi/4, thus |t| < 0.1 */
+   t = dd_mul_2si (r, -3);
+   z = dd_mul (t, t);
+
+   /* sin(t) up to degree 17 and versin(t) = 1 - cos(t) up to degree 18;
+      the series are alternating with decreasing terms, so that the
+      remainders are bounded by the first neglected terms */
+   sr = dd_const (inv_fact [17]);
+   for (n = 15; n >= 1; n -= 2)
+      sr = dd_sub (dd_const (inv_fact [n]), dd_mul (sr, z));
+   sr = dd_mul (sr, t);
+   vr = dd_const (inv_fact [18]);
+   for (n = 16; n >= 2; n -= 2)
+      vr = dd_sub (dd_const (inv_fact [n]), dd_mul (vr, z));
+   vr = dd_mul (vr, z);
+   a = fabs (t.hi) + fabs (t.lo);
+   b = a * a;
+   b = b * b;
+   b = b * b;
+   b = b * b * a * a; /* a^18 */
+   sr.err = DD_UP (sr.err + b * a * inv_fact [19][0]);
+   vr.err = DD_UP (vr.err + b * a * a * inv_fact [20][0]);
+
+   /* sin(2t) = 2 sin(t) (1 - versin(t)), versin(2t) = 2 sin(t)^2 */
+   for (n = 0; n < 3; n++) {
+      tmp = dd_mul_2si (dd_mul (sr, sr), 1);
+      sr = dd_mul_2si (dd_mul (sr, dd_sub (dd_d (1), vr)), 1);
+      vr = tmp;
+   }
+   vr = dd_sub (dd_d (1), vr);
+
+   switch (k & 3) {
+   case 0:
+      *s = sr;
+      *c = vr;
+      break;
+   case 1:
+      *s = vr;
+      *c = dd_neg (sr);
+      break;
+   case 2:
+      *s = dd_neg (sr);
+      *c = dd_neg (vr);
+      break;
+   default:
+      *s = dd_neg (vr);
+      *c = sr;
+   }
+}
+
+
+static void dd_sinh_cosh (dd_t *sh, dd_t *ch, dd_t x)
+   /* Set sh and ch to sinh(x) and cosh(x). Assumes |x| < 256. */
+{
+   dd_t e, p, q;
+   long k;
+
+   e = dd_exp (x, &k);
+   if (k == 0) {
+      /* avoid the cancellation in sinh for small x:
+         sinh(x) = (e + e/(1+e))/2 and cosh(x) = 1 + e^2/(2(1+e))
+         with e = expm1(x) */
+      p = dd_add (dd_d (1), e);
+      *sh = dd_mul_2si (dd_add (e, dd_div (e, p)), -1);
+      *ch = dd_add (dd_d (1), dd_mul_2si (dd_div (dd_mul (e, e), p), -1));
+   }
+   else {
+      p = dd_mul_2si (dd_add (dd_d (1), e), (int) k - 1);
+      q = dd_div (dd_d (0.25), p);
+      *sh = dd_sub (p, q);
+      *ch = dd_add (p, q);
+   }
+}
+
+
+/*
+ * Conversion from and to MPFR
+ */
+
+static int dd_get (dd_t *r, mpfr_srcptr x, mpfr_ptr tmp)
+   /* Set r to x if it is zero or a regular number of at most 106 bits in
+      the admissible range and return 1, otherwise return 0; tmp is a
+      temporary variable of at least 53 bits. The low part, of exponent
+      down to Exp(x) - 2*53, must lie in the current exponent range, as
+      well as the high part, which may be rounded up to 2^Exp(x). */
+{
+   if (mpfr_zero_p (x)) {
+      *r = dd_d (0);
+      return 1;
+   }
+   else if (!mpfr_regular_p (x)
+            || mpfr_get_exp (x) > DD_EXP_MAX
+            || mpfr_get_exp (x) < -DD_EXP_MAX
+            || mpfr_get_prec (x) > 2 * DBL_MANT_DIG
+            || mpfr_get_exp (x) + 1 > mpfr_get_emax ()
+            || (mpfr_get_prec (x) > DBL_MANT_DIG
+                && mpfr_get_exp (x) - 2 * DBL_MANT_DIG < mpfr_get_emin ()))
+      return 0;
+
+   *r = dd_d (mpfr_get_d (x, MPFR_RNDN));
+   if (mpfr_get_prec (x) > DBL_MANT_DIG) {
+      /* the difference has at most 53 bits and is exact */
+      mpfr_sub_d (tmp, x, r->hi, MPFR_RNDN);
+      r->lo = mpfr_get_d (tmp, MPFR_RNDN);
+   }
+   return 1;
+}
+
+
+static int dd_round (mpfr_ptr t, dd_t x, long k, mpfr_prec_t prec,
+   mpfr_rnd_t rnd)
+   /* Set t to an approximation of x*2^k and return 1 if it can be rounded
+      correctly to precision prec in the direction rnd, and the result
+      lies in the current exponent range; otherwise return 0.
+      The precision of t is DD_TMP_PREC. */
+{
+   int e, ee;
+   mpfr_exp_t err;
+
+   if (x.hi == 0 || !(fabs (x.hi) <= DBL_MAX) || !(x.err <= DBL_MAX))
+      return 0;
+
+   /* the exponent of the rounded result differs by at most 1 from the
+      exponent of x.hi */
+   frexp (x.hi, &e);
+   if (   e - 1 < mpfr_get_emin () || e + 1 > mpfr_get_emax ()
+       || e + k - 1 < mpfr_get_emin () || e + k + 1 > mpfr_get_emax ())
+      return 0;
+
+   mpfr_set_d (t, x.hi, MPFR_RNDN);
+   if (mpfr_add_d (t, t, x.lo, MPFR_RNDN) != 0 || x.err != 0) {
+      /* The error is bounded by x.err plus half an ulp of t, and thus by
+         2^(Exp(t)-err). */
+      if (x.err == 0)
+         err = DD_TMP_PREC;
+      else {
+         frexp (x.err, &ee);
+         err = MPC_MIN (mpfr_get_exp (t) - ee, DD_TMP_PREC + 1) - 1;
+      }
+      if (err <= prec + 1
+          || !mpfr_can_round (t, err, MPFR_RNDN, MPFR_RNDZ,
+                              prec + (rnd == MPFR_RNDN)))
+         return 0;
+   }
+
+   if (k != 0)
+      mpfr_mul_2si (t, t, k, MPFR_RNDN);
+   return 1;
+}
+
+
+/*
+ * Fast paths
+ */
+
+int
+mpc_div_dd (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd,
+   int *inex)
+{
+   mpc_t t;
+   dd_t a, b, c, d, n;
+   int ok;
+
+   if (!MPC_USE_DD || MPC_MAX_PREC (rop) > DD_MAX_PREC)
+      return 0;
+
+   mpc_tmp_init2 (t, DD_TMP_PREC);
+   ok =    dd_get (&a, mpc_realref (op1), mpc_realref (t))
+        && dd_get (&b, mpc_imagref (op1), mpc_realref (t))
+        && dd_get (&c, mpc_realref (op2), mpc_realref (t))
+        && dd_get (&d, mpc_imagref (op2), mpc_realref (t));
+   if (ok) {
+      /* (a+i*b) / (c+i*d) = ((a*c+b*d) + i*(b*c-a*d)) / (c^2+d^2) */
+      n = dd_add (dd_mul (c, c), dd_mul (d, d));
+      ok =    dd_round (mpc_realref (t),
+                        dd_div (dd_add (dd_mul (a, c), dd_mul (b, d)), n),
+                        0, MPC_PREC_RE (rop), MPC_RND_RE (rnd))
+           && dd_round (mpc_imagref (t),
+                        dd_div (dd_sub (dd_mul (b, c), dd_mul (a, d)), n),
+                        0, MPC_PREC_IM (rop), MPC_RND_IM (rnd));
+   }
+   if (ok)
+      *inex = mpc_set (rop, t, rnd);
+   mpc_tmp_clear (t);
+
+   return ok;
+}
+
+
+int
+mpc_exp_dd (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd, int *inex)
+   /* Assumes that both parts of op are regular numbers. */
+{
+   mpc_t t;
+   dd_t a, b, e, s, c;
+   long k;
+   int ok;
+
+   if (!MPC_USE_DD || MPC_MAX_PREC (rop) > DD_MAX_PREC
+       || mpfr_get_exp (mpc_realref (op)) > 20
+       || mpfr_get_exp (mpc_imagref (op)) > 20)
+      return 0;
+
+   mpc_tmp_init2 (t, DD_TMP_PREC);
+   ok =    dd_get (&a, mpc_realref (op), mpc_realref (t))
+        && dd_get (&b, mpc_imagref (op), mpc_realref (t));
+   if (ok) {
+      /* exp(a+i*b) = 2^k * (1+e) * (cos(b) + i*sin(b)) */
+      e = dd_add (dd_d (1), dd_exp (a, &k));
+      dd_sin_cos (&s, &c, b);
+      ok =    dd_round (mpc_realref (t), dd_mul (e, c), k,
+                        MPC_PREC_RE (rop), MPC_RND_RE (rnd))
+           && dd_round (mpc_imagref (t), dd_mul (e, s), k,
+                        MPC_PREC_IM (rop), MPC_RND_IM (rnd));
+   }
+   if (ok)
+      *inex = mpc_set (rop, t, rnd);
+   mpc_tmp_clear (t);
+
+   return ok;
+}
+
+
+static int
+dd_arg (dd_t *th, dd_t a, dd_t b)
+   /* Set *th to atan2(b,a) and return 1, or return 0 if the first order
+      approximation is not accurate enough; a+i*b must be non-zero. */
+{
+   dd_t s, c, u;
+   double th0, ua;
+
+   /* atan2(b,a) = th0 + atan(u) with th0 an approximation of atan2(b,a)
+      in double precision and
+      u = tan(atan2(b,a)-th0) = (b*cos(th0)-a*sin(th0))
+                                / (a*cos(th0)+b*sin(th0));
+      then atan(u) = u - u^3/3 + r with |r| <= |u|^5/5. */
+   th0 = atan2 (b.hi, a.hi);
+   dd_sin_cos (&s, &c, dd_d (th0));
+   u = dd_div (dd_sub (dd_mul (b, c), dd_mul (a, s)),
+               dd_add (dd_mul (a, c), dd_mul (b, s)));
+   ua = dd_abs (u);
+   if (!(ua <= DD_NEWTON_MAX))
+      return 0;
+
+   /* u^3/3 = 2 * u^3/3! */
+   u = dd_sub (u, dd_mul_2si (dd_mul (dd_mul (dd_mul (u, u), u),
+                                      dd_const (inv_fact [3])), 1));
+   *th = dd_add (dd_d (th0), u);
+   th->err = DD_UP (th->err + ua * ua * ua * ua * ua / 5);
+   return 1;
+}
+
+
+static int
+log_dd (mpc_ptr rop, mpc_srcptr op, const double *scale, mpc_rnd_t rnd,
+        int *inex)
+   /* Fast path for log(op), multiplied by the double-double constant
+      scale unless it is NULL; assumes that both parts of op are regular
+      numbers. */
+{
+   mpc_t t;
+   dd_t a, b, n, w, l, u;
+   double y0, wa;
+   long k;
+   int ok;
+
+   if (!MPC_USE_DD || MPC_MAX_PREC (rop) > DD_MAX_PREC)
+      return 0;
+
+   mpc_tmp_init2 (t, DD_TMP_PREC);
+   ok =    dd_get (&a, mpc_realref (op), mpc_realref (t))
+        && dd_get (&b, mpc_imagref (op), mpc_realref (t));
+   if (ok) {
+      /* Re(log(a+i*b)) = log(n)/2 with n = a^2+b^2. Starting from an
+         approximation y0 of log(n) in double precision, let
+         w = n*exp(-y0) - 1, which is small; then
+         log(n) = y0 + log(1+w) = y0 + w - w^2/2 + r with |r| <= |w|^3/2.
+         The bound does not depend on the accuracy of y0. */
+      n = dd_add (dd_mul (a, a), dd_mul (b, b));
+      y0 = log (n.hi);
+      w = dd_exp (dd_d (-y0), &k);
+      w = dd_mul_2si (dd_mul (n, dd_add (dd_d (1), w)), (int) k);
+      w = dd_sub (w, dd_d (1));
+      wa = dd_abs (w);
+      ok = (wa <= DD_NEWTON_MAX);
+   }
+   if (ok) {
+      l = dd_add (dd_d (y0), dd_sub (w, dd_mul_2si (dd_mul (w, w), -1)));
+      l.err = DD_UP (l.err + wa * wa * wa / 2);
+      /* Im(log(a+i*b)) = atan2(b,a) */
+      ok = dd_arg (&u, a, b);
+   }
+   if (ok) {
+      l = dd_mul_2si (l, -1);
+      if (scale != NULL) {
+         l = dd_mul (l, dd_const (scale));
+         u = dd_mul (u, dd_const (scale));
+      }
+      ok =    dd_round (mpc_realref (t), l, 0,
+                        MPC_PREC_RE (rop), MPC_RND_RE (rnd))
+           && dd_round (mpc_imagref (t), u, 0,
+                        MPC_PREC_IM (rop), MPC_RND_IM (rnd));
+   }
+   if (ok)
+      *inex = mpc_set (rop, t, rnd);
+   mpc_tmp_clear (t);
+
+   return ok;
+}
+
+
+int
+mpc_log_dd (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd, int *inex)
+   /* Assumes that both parts of op are regular numbers. */
+{
+   return log_dd (rop, op, NULL, rnd, inex);
+}
+
+
+int
+mpc_log_base_dd (mpc_ptr rop, mpc_srcptr op, int base, mpc_rnd_t rnd,
+                 int *inex)
+   /* Computes log(op)/log(base) for base 2 or 10; assumes that both parts
+      of op are regular numbers. */
+{
+   return log_dd (rop, op, base == 2 ? inv_ln2 : inv_ln10, rnd, inex);
+}
+
+
+int
+mpc_sin_cos_dd (mpc_ptr rop_sin, mpc_ptr rop_cos, mpc_srcptr op,
+   mpc_rnd_t rnd_sin, mpc_rnd_t rnd_cos, int *inex)
+   /* Assumes that both parts of op are regular numbers; one of rop_sin
+      and rop_cos may be NULL. */
+{
+   mpc_t ts, tc;
+   dd_t a, b, s, c, sh, ch;
+   int ok, inex_sin, inex_cos;
+
+   if (!MPC_USE_DD
+       || (rop_sin != NULL && MPC_MAX_PREC (rop_sin) > DD_MAX_PREC)
+       || (rop_cos != NULL && MPC_MAX_PREC (rop_cos) > DD_MAX_PREC)
+       || mpfr_get_exp (mpc_realref (op)) > 20
+       || mpfr_get_exp (mpc_imagref (op)) > 8)
+      return 0;
+
+   mpc_tmp_init2 (ts, DD_TMP_PREC);
+   mpc_tmp_init2 (tc, DD_TMP_PREC);
+   ok =    dd_get (&a, mpc_realref (op), mpc_realref (ts))
+        && dd_get (&b, mpc_imagref (op), mpc_realref (ts));
+   if (ok) {
+      /* sin(a+i*b) = sin(a)*cosh(b) + i*cos(a)*sinh(b),
+         cos(a+i*b) = cos(a)*cosh(b) - i*sin(a)*sinh(b) */
+      dd_sin_cos (&s, &c, a);
+      dd_sinh_cosh (&sh, &ch, b);
+      if (rop_sin != NULL)
+         ok =    dd_round (mpc_realref (ts), dd_mul (s, ch), 0,
+                           MPC_PREC_RE (rop_sin), MPC_RND_RE (rnd_sin))
+              && dd_round (mpc_imagref (ts), dd_mul (c, sh), 0,
+                           MPC_PREC_IM (rop_sin), MPC_RND_IM (rnd_sin));
+      if (ok && rop_cos != NULL)
+         ok =    dd_round (mpc_realref (tc), dd_mul (c, ch), 0,
+                           MPC_PREC_RE (rop_cos), MPC_RND_RE (rnd_cos))
+              && dd_round (mpc_imagref (tc), dd_neg (dd_mul (s, sh)), 0,
+                           MPC_PREC_IM (rop_cos), MPC_RND_IM (rnd_cos));
+   }
+   if (ok) {
+      inex_sin = (rop_sin != NULL ? mpc_set (rop_sin, ts, rnd_sin) : 0);
+      inex_cos = (rop_cos != NULL ? mpc_set (rop_cos, tc, rnd_cos) : 0);
+      *inex = MPC_INEX12 (inex_sin, inex_cos);
+   }
+   mpc_tmp_clear (tc);
+   mpc_tmp_clear (ts);
+
+   return ok;
+}
+
+
+int
+mpc_get_polar_dd (mpfr_ptr r, mpfr_ptr theta, mpc_srcptr op, mpc_rnd_t rnd,
+   int *inex)
+   /* Assumes that both parts of op are regular numbers. */
+{
+   mpc_t t;
+   dd_t a, b, u;
+   int ok, inex_r, inex_theta;
+
+   if (!MPC_USE_DD || mpfr_get_prec (r) > DD_MAX_PREC
+       || mpfr_get_prec (theta) > DD_MAX_PREC)
+      return 0;
+
+   mpc_tmp_init2 (t, DD_TMP_PREC);
+   ok =    dd_get (&a, mpc_realref (op), mpc_realref (t))
+        && dd_get (&b, mpc_imagref (op), mpc_realref (t))
+        && dd_arg (&u, a, b);
+   if (ok)
+      ok =    dd_round (mpc_realref (t),
+                        dd_sqrt (dd_add (dd_mul (a, a), dd_mul (b, b))), 0,
+                        mpfr_get_prec (r), MPC_RND_RE (rnd))
+           && dd_round (mpc_imagref (t), u, 0,
+                        mpfr_get_prec (theta), MPC_RND_IM (rnd));
+   if (ok) {
+      inex_r = mpfr_set (r, mpc_realref (t), MPC_RND_RE (rnd));
+      inex_theta = mpfr_set (theta, mpc_imagref (t), MPC_RND_IM (rnd));
+      *inex = MPC_INEX (inex_r, inex_theta);
+   }
+   mpc_tmp_clear (t);
+
+   return ok;
+}
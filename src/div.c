@@ -1,6 +1,6 @@
 /* mpc_div -- Divide two complex numbers.
 
-Copyright (C) 2002, 2003, 2004, 2005, 2008, 2009, 2010, 2011, 2012, 2020 INRIA
+Copyright (C) 2002, 2003, 2004, 2005, 2008, 2009, 2010, 2011, 2012, 2020, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -274,6 +274,9 @@ mpc_div (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
    else if (mpfr_zero_p(mpc_realref(c)))
       return mpc_div_imag (a, b, c, rnd);
 
+   if (mpc_div_dd (a, b, c, rnd, &inex))
+      return inex;
+
    prec = MPC_MAX_PREC(a);
 
    mpc_init2 (res, 2);
@@ -0,0 +1,134 @@
+/* mpc_div_prepare, mpc_div_prepared, mpc_divisor_clear --
+   Division of many complex numbers by the same divisor.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* For a divisor w with two regular parts, let k be the larger of their
+   exponents and c = conj(w) * 2^(-k), whose larger part lies in [1/2, 1);
+   then z/w = z*c / |c|^2 * 2^(-k). The prepared divisor holds c and an
+   approximation inv to 1/|c|^2 at the working precision p, which is
+   obtained with two roundings, so that inv = (1+t)/|c|^2 with
+   |t| < 2^(1-p) + 2^(-2p). For each dividend, the parts of z*c are
+   correctly rounded by mpc_mul and multiplied by inv with another
+   rounding; the relative error of each part of the quotient is thus
+   bounded by (1+2^(-p))^2 (1+t) - 1 < 2^(2-p) * 1.01, and its absolute
+   error by 8 ulp, as in mpc_vec_div. Whenever this does not allow to
+   round correctly, in particular when one of the parts of z/w is exact,
+   or when the result is close to the limits of the exponent range, the
+   division is done by mpc_div on the saved copy of w. */
+
+void
+mpc_div_prepare (mpc_divisor_ptr d, mpc_srcptr w, mpfr_prec_t prec)
+{
+   mpfr_exp_t saved_emin, saved_emax;
+   mpfr_prec_t p;
+
+   mpc_init3 (&d->w, MPC_PREC_RE (w), MPC_PREC_IM (w));
+   mpc_set (&d->w, w, MPC_RNDNN); /* exact */
+   mpc_init3 (&d->c, MPC_PREC_RE (w), MPC_PREC_IM (w));
+   p = prec + mpc_ceil_log2 (prec) + 5;
+   mpfr_init2 (&d->inv, p);
+   d->prec = prec;
+   d->k = 0;
+   d->regular = mpfr_regular_p (mpc_realref (w))
+                && mpfr_regular_p (mpc_imagref (w));
+   if (!d->regular)
+      return;
+
+   saved_emin = mpfr_get_emin ();
+   saved_emax = mpfr_get_emax ();
+   mpfr_set_emin (mpfr_get_emin_min ());
+   mpfr_set_emax (mpfr_get_emax_max ());
+
+   d->k = MPC_MAX (mpfr_get_exp (mpc_realref (w)),
+                   mpfr_get_exp (mpc_imagref (w)));
+   mpc_conj (&d->c, w, MPC_RNDNN);
+   mpfr_mul_2si (mpc_realref (&d->c), mpc_realref (&d->c), -d->k,
+                 MPFR_RNDN); /* exact */
+   mpfr_mul_2si (mpc_imagref (&d->c), mpc_imagref (&d->c), -d->k,
+                 MPFR_RNDN);
+   mpc_norm (&d->inv, &d->c, MPFR_RNDN);
+   mpfr_ui_div (&d->inv, 1, &d->inv, MPFR_RNDN);
+
+   mpfr_set_emin (saved_emin);
+   mpfr_set_emax (saved_emax);
+}
+
+void
+mpc_divisor_clear (mpc_divisor_ptr d)
+{
+   mpc_clear (&d->w);
+   mpc_clear (&d->c);
+   mpfr_clear (&d->inv);
+}
+
+int
+mpc_div_prepared (mpc_ptr rop, mpc_srcptr z, mpc_divisor_srcptr d,
+   mpc_rnd_t rnd)
+{
+   mpc_t t;
+   mpfr_ptr re, im;
+   mpfr_exp_t emin, emax, e_re, e_im;
+   mpfr_prec_t p;
+   int ok, inex_re, inex_im;
+
+   if (!d->regular || MPC_MAX_PREC (rop) > d->prec)
+      return mpc_div (rop, z, &d->w, rnd);
+
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   mpfr_set_emin (mpfr_get_emin_min ());
+   mpfr_set_emax (mpfr_get_emax_max ());
+
+   p = mpfr_get_prec (&d->inv);
+   mpc_tmp_init2 (t, p);
+   re = mpc_realref (t);
+   im = mpc_imagref (t);
+   mpc_mul (t, z, &d->c, MPC_RNDNN);
+   ok = mpfr_regular_p (re) && mpfr_regular_p (im);
+   if (ok) {
+      mpfr_mul (re, re, &d->inv, MPFR_RNDN);
+      mpfr_mul (im, im, &d->inv, MPFR_RNDN);
+      e_re = mpfr_get_exp (re) - d->k;
+      e_im = mpfr_get_exp (im) - d->k;
+      ok = e_re > emin && e_re < emax && e_im > emin && e_im < emax
+         && mpfr_can_round (re, p - 3, MPFR_RNDN, MPFR_RNDZ,
+               MPC_PREC_RE (rop) + (MPC_RND_RE (rnd) == MPFR_RNDN))
+         && mpfr_can_round (im, p - 3, MPFR_RNDN, MPFR_RNDZ,
+               MPC_PREC_IM (rop) + (MPC_RND_IM (rnd) == MPFR_RNDN));
+   }
+   if (ok) {
+      /* the rounded results and their scaling are in the exponent range
+         of the caller */
+      inex_re = mpfr_set (mpc_realref (rop), re, MPC_RND_RE (rnd));
+      inex_im = mpfr_set (mpc_imagref (rop), im, MPC_RND_IM (rnd));
+      mpfr_mul_2si (mpc_realref (rop), mpc_realref (rop), -d->k, MPFR_RNDN);
+      mpfr_mul_2si (mpc_imagref (rop), mpc_imagref (rop), -d->k, MPFR_RNDN);
+   }
+   mpc_tmp_clear (t);
+
+   mpfr_set_emin (emin);
+   mpfr_set_emax (emax);
+
+   if (!ok)
+      return mpc_div (rop, z, &d->w, rnd);
+   return MPC_INEX (inex_re, inex_im);
+}
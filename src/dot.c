@@ -1,6 +1,7 @@
-/* mpc_dot -- Dot product of two arrays of complex numbers.
+/* mpc_dot, mpc_dot_init, mpc_dot_clear, mpc_dot_add, mpc_dot_get --
+   Dot product of two arrays of complex numbers.
 
-Copyright (C) 2018, 2020 INRIA
+Copyright (C) 2018, 2020, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -18,77 +19,89 @@ You should have received a copy of the GNU Lesser General Public License
 along with this program. If not, see http://www.gnu.org/licenses/ .
 */
 
-#include <stdio.h> /* for MPC_ASSERT */
 #include "mpc-impl.h"
 
+/* The real and imaginary parts of the dot product are kept as exact sums,
+   to which the products are added exactly, one at a time; so the memory
+   depends on the precisions of the products and the clusters of their
+   exponents, but not on the number of terms, and the only allocations
+   occur when the exact sums or the precision of the temporary variable
+   for the products grow. */
+
+void
+mpc_dot_init (mpc_dot_ptr d)
+{
+  mpc_fsum_init (&d->re);
+  mpc_fsum_init (&d->im);
+  mpfr_init2 (&d->tmp, MPFR_PREC_MIN);
+}
+
+void
+mpc_dot_clear (mpc_dot_ptr d)
+{
+  mpc_fsum_clear (&d->re);
+  mpc_fsum_clear (&d->im);
+  mpfr_clear (&d->tmp);
+}
+
+/* d <- d + x*y */
+void
+mpc_dot_add (mpc_dot_ptr d, mpc_srcptr x, mpc_srcptr y)
+{
+  mpfr_ptr t = &d->tmp;
+  mpfr_exp_t saved_emin, saved_emax;
+
+  saved_emin = mpfr_get_emin ();
+  saved_emax = mpfr_get_emax ();
+  mpfr_set_emin (mpfr_get_emin_min ());
+  mpfr_set_emax (mpfr_get_emax_max ());
+
+  /* all products are exact; mpfr_set_prec does not reallocate t when
+     its precision decreases */
+  mpfr_set_prec (t, MPC_PREC_RE (x) + MPC_PREC_RE (y));
+  mpfr_mul (t, mpc_realref (x), mpc_realref (y), MPFR_RNDZ);
+  mpc_fsum_add (&d->re, t);
+  mpfr_set_prec (t, MPC_PREC_IM (x) + MPC_PREC_IM (y));
+  mpfr_mul (t, mpc_imagref (x), mpc_imagref (y), MPFR_RNDZ);
+  mpfr_neg (t, t, MPFR_RNDZ);
+  mpc_fsum_add (&d->re, t);
+  mpfr_set_prec (t, MPC_PREC_RE (x) + MPC_PREC_IM (y));
+  mpfr_mul (t, mpc_realref (x), mpc_imagref (y), MPFR_RNDZ);
+  mpc_fsum_add (&d->im, t);
+  mpfr_set_prec (t, MPC_PREC_IM (x) + MPC_PREC_RE (y));
+  mpfr_mul (t, mpc_imagref (x), mpc_realref (y), MPFR_RNDZ);
+  mpc_fsum_add (&d->im, t);
+
+  mpfr_set_emin (saved_emin);
+  mpfr_set_emax (saved_emax);
+}
+
+/* res <- d, which is not modified, so that more terms may be added */
+int
+mpc_dot_get (mpc_ptr res, mpc_dot_srcptr d, mpc_rnd_t rnd)
+{
+  int inex_re, inex_im;
+
+  inex_re = mpc_fsum_get (mpc_realref (res), &d->re, MPC_RND_RE (rnd));
+  inex_im = mpc_fsum_get (mpc_imagref (res), &d->im, MPC_RND_IM (rnd));
+
+  return MPC_INEX(inex_re, inex_im);
+}
+
 /* res <- x[0]*y[0] + ... + x[n-1]*y[n-1] */
 int
 mpc_dot (mpc_ptr res, const mpc_ptr *x, const mpc_ptr *y,
          unsigned long n, mpc_rnd_t rnd)
 {
-  int inex_re, inex_im;
-  mpfr_ptr *t;
-  mpfr_t *z;
+  mpc_dot_t d;
   unsigned long i;
-  mpfr_t re_res;
-
-  /* avoid a compiler warning when n=0 */
-  if (n == 0)
-    {
-      mpc_set_ui_ui (res, 0, 0, rnd);
-      return MPC_INEX(0, 0);
-    }
-
-  z = (mpfr_t *) malloc (2 * n * sizeof (mpfr_t));
-  MPC_ASSERT(z != NULL);
-  t = (mpfr_ptr *) malloc (2 * n * sizeof(mpfr_ptr));
-  MPC_ASSERT(t != NULL);
-  for (i = 0; i < 2 * n; i++)
-    t[i] = z[i];
-  /* we first store in z[i] the value of Re(x[i])*Re(y[i])
-     and in z[n+i] that of -Im(x[i])*Im(y[i]) */
-  for (i = 0; i < n; i++)
-    {
-      mpfr_prec_t prec_x_re = mpfr_get_prec (mpc_realref (x[i]));
-      mpfr_prec_t prec_x_im = mpfr_get_prec (mpc_imagref (x[i]));
-      mpfr_prec_t prec_y_re = mpfr_get_prec (mpc_realref (y[i]));
-      mpfr_prec_t prec_y_im = mpfr_get_prec (mpc_imagref (y[i]));
-      mpfr_prec_t prec_y_max = MPC_MAX (prec_y_re, prec_y_im);
-      /* we allocate z[i] with prec_x_re + prec_y_max bits
-         so that the second loop below does not reallocate */
-      mpfr_init2 (z[i], prec_x_re + prec_y_max);
-      mpfr_set_prec (z[i], prec_x_re + prec_y_re);
-      mpfr_mul (z[i], mpc_realref (x[i]), mpc_realref (y[i]), MPFR_RNDZ);
-      /* idem for z[n+i]: we allocate with prec_x_im + prec_y_max bits */
-      mpfr_init2 (z[n+i], prec_x_im + prec_y_max);
-      mpfr_set_prec (z[n+i], prec_x_im + prec_y_im);
-      mpfr_mul (z[n+i], mpc_imagref (x[i]), mpc_imagref (y[i]), MPFR_RNDZ);
-      mpfr_neg (z[n+i], z[n+i], MPFR_RNDZ);
-    }
-  /* copy the real part in a temporary variable, since it might be in the
-     input array */
-  mpfr_init2 (re_res, mpfr_get_prec (mpc_realref (res)));
-  inex_re = mpfr_sum (re_res, t, 2 * n, MPC_RND_RE (rnd));
-  /* we then store in z[i] the value of Re(x[i])*Im(y[i])
-     and in z[n+i] that of Im(x[i])*Re(y[i]) */
+  int inex;
+
+  mpc_dot_init (d);
   for (i = 0; i < n; i++)
-    {
-      mpfr_prec_t prec_x_re = mpfr_get_prec (mpc_realref (x[i]));
-      mpfr_prec_t prec_x_im = mpfr_get_prec (mpc_imagref (x[i]));
-      mpfr_prec_t prec_y_re = mpfr_get_prec (mpc_realref (y[i]));
-      mpfr_prec_t prec_y_im = mpfr_get_prec (mpc_imagref (y[i]));
-      mpfr_set_prec (z[i], prec_x_re + prec_y_im);
-      mpfr_mul (z[i], mpc_realref (x[i]), mpc_imagref (y[i]), MPFR_RNDZ);
-      mpfr_set_prec (z[n+i], prec_x_im + prec_y_re);
-      mpfr_mul (z[n+i], mpc_imagref (x[i]), mpc_realref (y[i]), MPFR_RNDZ);
-    }
-  inex_im = mpfr_sum (mpc_imagref (res), t, 2 * n, MPC_RND_IM (rnd));
-  mpfr_swap (mpc_realref (res), re_res);
-  mpfr_clear (re_res);
-  for (i = 0; i < 2 * n; i++)
-    mpfr_clear (z[i]);
-  free (t);
-  free (z);
+    mpc_dot_add (d, x[i], y[i]);
+  inex = mpc_dot_get (res, d, rnd);
+  mpc_dot_clear (d);
 
-  return MPC_INEX(inex_re, inex_im);
+  return inex;
 }
@@ -1,6 +1,6 @@
 /* eta -- Functions for computing the Dedekind eta function
 
-Copyright (C) 2022, 2024 INRIA
+Copyright (C) 2022, 2024, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -117,7 +117,7 @@ mpcb_eta_q24 (mpcb_ptr eta, mpcb_srcptr q24)
          /* Compute an approximate N such that
             (3*N+1)*N/2 * |expq| > prec. */
          target = (2 * mpcb_get_prec (q24)) / (3 * (-expq)) + 1;
-         for (N = 2; N * N <= target; N += N / 2);
+         for (N = 2; N * N <= target; N += MPC_MAX (1, N / ETA_TERMS_STEP));
          eta_series (eta, q, expq, N);
          mpcb_mul (eta, eta, q24);
       }
@@ -175,7 +175,7 @@ q24_from_z (mpcb_ptr q24, mpc_srcptr z, unsigned long int err_re,
       mpfr_init2 (s, p);
       mpc_init2 (q24c, p);
 
-      mpfr_const_pi (pi, MPFR_RNDD);
+      mpc_const_pi (pi, MPFR_RNDD);
       mpfr_div_ui (pi, pi, 12, MPFR_RNDD);
       mpfr_mul (u, mpc_imagref (z), pi, MPFR_RNDD);
       mpfr_neg (u, u, MPFR_RNDU);
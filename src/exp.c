@@ -1,6 +1,6 @@
 /* mpc_exp -- exponential of a complex number.
 
-Copyright (C) 2002, 2009, 2010, 2011, 2012, 2020, 2024 INRIA
+Copyright (C) 2002, 2009, 2010, 2011, 2012, 2020, 2024, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -25,7 +25,7 @@ mpc_exp (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
 {
   mpfr_t x, y, z;
   mpfr_prec_t prec;
-  int ok = 0;
+  int ok_re = 0, ok_im = 0, reduced;
   int inex_re, inex_im;
   int saved_underflow, saved_overflow;
   mpfr_exp_t saved_emin, saved_emax;
@@ -129,6 +129,9 @@ mpc_exp (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
       return MPC_INEX(0, 0); /* NaN is exact */
     }
 
+  if (mpc_exp_dd (rop, op, rnd, &inex_re))
+    return inex_re;
+
   saved_emin = mpfr_get_emin ();
   saved_emax = mpfr_get_emax ();
   mpfr_set_emin (mpfr_get_emin_min ());
@@ -143,41 +146,55 @@ mpc_exp (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
        cos is close to 1-Im(op); to decide on the ternary value of exp*cos,
        we need a high enough precision so that none of exp or cos is
        computed as 1. */
-  mpfr_init2 (x, 2);
-  mpfr_init2 (y, 2);
-  mpfr_init2 (z, 2);
+  /* A few guard bits almost always suffice, so that the working precision
+     only grows geometrically after a failure; once one part can be
+     rounded, only the other one is recomputed, with mpfr_cos or mpfr_sin
+     instead of mpfr_sin_cos. */
+  prec += mpc_ceil_log2 (prec) + 5;
+  mpc_tmp_fr_init2 (x, prec);
+  mpc_tmp_fr_init2 (y, prec);
+  mpc_tmp_fr_init2 (z, prec);
 
   /* save the underflow or overflow flags from MPFR */
   saved_underflow = mpfr_underflow_p ();
   saved_overflow = mpfr_overflow_p ();
 
-  do
+  for (;;)
     {
-      prec += prec / 2 + mpc_ceil_log2 (prec) + 5;
-
-      mpfr_set_prec (x, prec);
-      mpfr_set_prec (y, prec);
-      mpfr_set_prec (z, prec);
-
       /* FIXME: x may overflow so x.y does overflow too, while Re(exp(op))
          could be represented in the precision of rop. */
       mpfr_clear_overflow ();
       mpfr_clear_underflow ();
       mpfr_exp (x, mpc_realref(op), MPFR_RNDN); /* error <= 0.5ulp */
-      mpfr_sin_cos (z, y, mpc_imagref(op), MPFR_RNDN); /* errors <= 0.5ulp */
-      mpfr_mul (y, y, x, MPFR_RNDN); /* error <= 2ulp */
-      ok = mpfr_overflow_p () || mpfr_zero_p (x)
-        || mpfr_can_round (y, prec - 2, MPFR_RNDN, MPFR_RNDZ,
+      /* errors <= 0.5ulp, or relative errors <= 2^(2-prec) if Im(op) is
+         large, in which case the errors below are <= 7ulp */
+      reduced = mpc_sin_cos_fr (ok_im ? NULL : z, ok_re ? NULL : y,
+                                mpc_imagref (op));
+
+      if (!ok_re)
+        {
+          mpfr_mul (y, y, x, MPFR_RNDN); /* error <= 2ulp */
+          ok_re = mpfr_overflow_p () || mpfr_zero_p (x)
+            || mpfr_can_round (y, prec - 2 - reduced, MPFR_RNDN, MPFR_RNDZ,
                        MPC_PREC_RE(rop) + (MPC_RND_RE(rnd) == MPFR_RNDN));
-      if (ok) /* compute imaginary part */
+        }
+      if (!ok_im)
         {
           mpfr_mul (z, z, x, MPFR_RNDN);
-          ok = mpfr_overflow_p () || mpfr_zero_p (x)
-            || mpfr_can_round (z, prec - 2, MPFR_RNDN, MPFR_RNDZ,
+          ok_im = mpfr_overflow_p () || mpfr_zero_p (x)
+            || mpfr_can_round (z, prec - 2 - reduced, MPFR_RNDN, MPFR_RNDZ,
                        MPC_PREC_IM(rop) + (MPC_RND_IM(rnd) == MPFR_RNDN));
         }
+      if (ok_re && ok_im)
+        break;
+
+      prec += prec / 2;
+      mpfr_set_prec (x, prec);
+      if (!ok_re)
+        mpfr_set_prec (y, prec);
+      if (!ok_im)
+        mpfr_set_prec (z, prec);
     }
-  while (ok == 0);
 
   inex_re = mpfr_set (mpc_realref(rop), y, MPC_RND_RE(rnd));
   inex_im = mpfr_set (mpc_imagref(rop), z, MPC_RND_IM(rnd));
@@ -192,9 +209,9 @@ mpc_exp (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
       inex_im = mpc_fix_zero (mpc_imagref(rop), MPC_RND_IM(rnd));
     }
 
-  mpfr_clear (x);
-  mpfr_clear (y);
-  mpfr_clear (z);
+  mpc_tmp_fr_clear (z);
+  mpc_tmp_fr_clear (y);
+  mpc_tmp_fr_clear (x);
 
   /* restore underflow and overflow flags from MPFR */
   if (saved_underflow)
@@ -1,6 +1,6 @@
 /* mpc_exp10 -- base-10 exponential of a complex number.
 
-Copyright (C) 2024 INRIA
+Copyright (C) 2024, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -23,11 +23,5 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 int
 mpc_exp10 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
 {
-  mpc_t ten;
-  int ret;
-  mpc_init2 (ten, 4); // 4 bits is enough to store 10 exactly
-  mpc_set_ui (ten, 10, MPC_RNDNN);
-  ret = mpc_pow (rop, ten, op, rnd);
-  mpc_clear (ten);
-  return ret;
+  return mpc_exp_base (rop, op, 10, rnd);
 }
@@ -1,6 +1,6 @@
 /* mpc_exp2 -- base-2 exponential of a complex number.
 
-Copyright (C) 2024 INRIA
+Copyright (C) 2024, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -20,14 +20,196 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 
 #include "mpc-impl.h"
 
+static int
+exp_base_real (mpfr_ptr rop, mpfr_srcptr op, int base, mpfr_rnd_t rnd)
+{
+   return (base == 2 ? mpfr_exp2 (rop, op, rnd) : mpfr_exp10 (rop, op, rnd));
+}
+
+/* Set rop to base^op = exp (op * log (base)) for base 2 or 10. The
+   special values are those of mpc_exp at op * log (base). */
+int
+mpc_exp_base (mpc_ptr rop, mpc_srcptr op, int base, mpc_rnd_t rnd)
+{
+   mpfr_t l, u, t, c, s;
+   mpfr_prec_t prec;
+   mpfr_exp_t err_re, err_im;
+   int loop = 0, inex_re, inex_im;
+   int saved_underflow, saved_overflow;
+   mpfr_exp_t saved_emin, saved_emax;
+
+   /* special values, as in mpc_exp */
+   if (mpfr_nan_p (mpc_realref (op)) || mpfr_nan_p (mpc_imagref (op))) {
+      if (mpfr_zero_p (mpc_imagref (op)))
+         return mpc_set (rop, op, MPC_RNDNN);
+      if (mpfr_inf_p (mpc_realref (op))) {
+         if (mpfr_signbit (mpc_realref (op)))
+            return mpc_set_ui_ui (rop, 0, 0, MPC_RNDNN);
+         mpfr_set_inf (mpc_realref (rop), +1);
+         mpfr_set_nan (mpc_imagref (rop));
+         return MPC_INEX (0, 0);
+      }
+      mpfr_set_nan (mpc_realref (rop));
+      mpfr_set_nan (mpc_imagref (rop));
+      return MPC_INEX (0, 0);
+   }
+
+   if (mpfr_zero_p (mpc_imagref (op))) {
+      /* real argument; base^x is exact when x is an integer and the
+         result is representable, which mpfr_exp2 and mpfr_exp10 detect */
+      inex_re = exp_base_real (mpc_realref (rop), mpc_realref (op), base,
+                               MPC_RND_RE (rnd));
+      inex_im = mpfr_set (mpc_imagref (rop), mpc_imagref (op),
+                          MPC_RND_IM (rnd));
+      return MPC_INEX (inex_re, inex_im);
+   }
+
+   if (mpfr_inf_p (mpc_imagref (op))) {
+      if (mpfr_inf_p (mpc_realref (op)) && mpfr_signbit (mpc_realref (op)))
+         return mpc_set_ui_ui (rop, 0, 0, MPC_RNDNN);
+      if (mpfr_inf_p (mpc_realref (op)))
+         mpfr_set_inf (mpc_realref (rop), +1);
+      else
+         mpfr_set_nan (mpc_realref (rop));
+      mpfr_set_nan (mpc_imagref (rop));
+      return MPC_INEX (0, 0);
+   }
+
+   if (mpfr_inf_p (mpc_realref (op))) {
+      /* base^(+-inf + i*y) = (+inf or 0) * (cos (y log (base))
+         + i * sin (y log (base))), where only the signs of the cosine and
+         of the sine matter; they are those of base^(i*y) rounded to
+         2 bits */
+      mpc_t z;
+      int sign = mpfr_signbit (mpc_realref (op));
+
+      mpc_init2 (z, 2);
+      mpfr_set_ui (mpc_realref (z), 0, MPFR_RNDN);
+      mpfr_set (mpc_imagref (z), mpc_imagref (op), MPFR_RNDN);
+      mpc_exp_base (z, z, base, MPC_RNDNN);
+      if (sign) {
+         mpfr_set_zero (mpc_realref (rop), mpfr_signbit (mpc_realref (z)) ? -1 : +1);
+         mpfr_set_zero (mpc_imagref (rop), mpfr_signbit (mpc_imagref (z)) ? -1 : +1);
+      }
+      else {
+         mpfr_set_inf (mpc_realref (rop), mpfr_signbit (mpc_realref (z)) ? -1 : +1);
+         mpfr_set_inf (mpc_imagref (rop), mpfr_signbit (mpc_imagref (z)) ? -1 : +1);
+      }
+      mpc_clear (z);
+      return MPC_INEX (0, 0);
+   }
+
+   saved_emin = mpfr_get_emin ();
+   saved_emax = mpfr_get_emax ();
+   mpfr_set_emin (mpfr_get_emin_min ());
+   mpfr_set_emax (mpfr_get_emax_max ());
+
+   /* from now on, x is finite and y is a regular number; as in mpc_exp,
+      when op is close to 0, the precision must be high enough so that
+      neither base^x nor the cosine is computed as 1; and the absolute
+      errors on x * log (base) and y * log (base) grow with x and y */
+   prec = MPC_MAX_PREC (rop)
+          + MPC_MAX (MPC_MAX (-mpfr_get_exp (mpc_imagref (op)), 0),
+                     mpfr_get_exp (mpc_imagref (op)));
+   if (!mpfr_zero_p (mpc_realref (op)))
+      prec = MPC_MAX (prec, MPC_MAX_PREC (rop)
+                            + MPC_MAX (-mpfr_get_exp (mpc_realref (op)),
+                                       mpfr_get_exp (mpc_realref (op))));
+   prec += mpc_ceil_log2 (prec) + 8;
+   mpc_tmp_fr_init2 (l, prec);
+   mpc_tmp_fr_init2 (u, prec);
+   mpc_tmp_fr_init2 (t, prec);
+   mpc_tmp_fr_init2 (c, prec);
+   mpc_tmp_fr_init2 (s, prec);
+
+   saved_underflow = mpfr_underflow_p ();
+   saved_overflow = mpfr_overflow_p ();
+
+   for (;;) {
+      mpfr_clear_overflow ();
+      mpfr_clear_underflow ();
+      /* The only scaling of the argument is (u, t) = o(op * l), where
+         l = log (base) with an error of at most 1 ulp (l), that is,
+         at most 2^(1-prec) * l; so the error on t is at most
+         2^(Exp (t) + 1 - prec) (1 + 2^(-prec)) + 1/2 ulp (t)
+         <= 2^(Exp (t) + 2 - prec), and this is also a bound on the error
+         of cos (t) and sin (t); and likewise for u. */
+      mpc_const_log_base (l, base);
+      mpfr_mul (u, mpc_realref (op), l, MPFR_RNDN);
+      mpfr_mul (t, mpc_imagref (op), l, MPFR_RNDN);
+      mpfr_sin_cos (s, c, t, MPFR_RNDN);
+
+      /* The error on c is at most (2^(Exp (t) + 2 - Exp (c)) + 1/2) ulp (c)
+         <= 2^k ulp (c) with k = max (Exp (t) + 2 - Exp (c), 0) + 1, that is,
+         a relative error of at most 2^(k + 1 - prec). Since
+         exp (delta) - 1 <= 1.3 delta for delta <= 1/2, the relative error
+         on the value r = o(exp (u)) is at most
+         2^(Exp (u) + 3 - prec) + 2^(-prec) <= 2^(kr - prec) with
+         kr = max (Exp (u) + 3, 0) + 1, and kr = 0 for u = 0. So the
+         relative error on c * r before rounding is at most
+         2^(max (k + 1, kr) + 1 - prec) (1 + 2^(-prec)), and the error on
+         o(c * r) is at most 2^(Exp + max (k + 1, kr) + 2 - prec).
+         The same holds for s. */
+      err_re = mpfr_zero_p (u) ? 0 : MPC_MAX (mpfr_get_exp (u) + 3, 0) + 1;
+      err_im = MPC_MAX (mpfr_get_exp (t) + 2 - mpfr_get_exp (s), 0) + 2;
+      err_im = MPC_MAX (err_im, err_re) + 2;
+      err_re = MPC_MAX (MPC_MAX (mpfr_get_exp (t) + 2 - mpfr_get_exp (c), 0)
+                        + 2, err_re) + 2;
+      mpfr_exp (u, u, MPFR_RNDN);
+      mpfr_mul (c, c, u, MPFR_RNDN);
+      mpfr_mul (s, s, u, MPFR_RNDN);
+      if (mpfr_overflow_p () || mpfr_zero_p (u)
+          || (mpfr_can_round (c, prec - err_re, MPFR_RNDN, MPFR_RNDZ,
+                 MPC_PREC_RE (rop) + (MPC_RND_RE (rnd) == MPFR_RNDN))
+              && mpfr_can_round (s, prec - err_im, MPFR_RNDN, MPFR_RNDZ,
+                 MPC_PREC_IM (rop) + (MPC_RND_IM (rnd) == MPFR_RNDN))))
+         break;
+
+      /* the first time, add the number of lost bits */
+      if (++loop == 1)
+         prec += MPC_MAX (err_re, err_im);
+      else
+         prec += prec / 2;
+      mpfr_set_prec (l, prec);
+      mpfr_set_prec (u, prec);
+      mpfr_set_prec (t, prec);
+      mpfr_set_prec (c, prec);
+      mpfr_set_prec (s, prec);
+   }
+
+   inex_re = mpfr_set (mpc_realref (rop), c, MPC_RND_RE (rnd));
+   inex_im = mpfr_set (mpc_imagref (rop), s, MPC_RND_IM (rnd));
+   if (mpfr_overflow_p ()) {
+      inex_re = mpc_fix_inf (mpc_realref (rop), MPC_RND_RE (rnd));
+      inex_im = mpc_fix_inf (mpc_imagref (rop), MPC_RND_IM (rnd));
+   }
+   else if (mpfr_underflow_p ()) {
+      inex_re = mpc_fix_zero (mpc_realref (rop), MPC_RND_RE (rnd));
+      inex_im = mpc_fix_zero (mpc_imagref (rop), MPC_RND_IM (rnd));
+   }
+
+   mpc_tmp_fr_clear (s);
+   mpc_tmp_fr_clear (c);
+   mpc_tmp_fr_clear (t);
+   mpc_tmp_fr_clear (u);
+   mpc_tmp_fr_clear (l);
+
+   if (saved_underflow)
+      mpfr_set_underflow ();
+   if (saved_overflow)
+      mpfr_set_overflow ();
+
+   /* restore the exponent range, and check the range of results */
+   mpfr_set_emin (saved_emin);
+   mpfr_set_emax (saved_emax);
+   inex_re = mpfr_check_range (mpc_realref (rop), inex_re, MPC_RND_RE (rnd));
+   inex_im = mpfr_check_range (mpc_imagref (rop), inex_im, MPC_RND_IM (rnd));
+
+   return MPC_INEX (inex_re, inex_im);
+}
+
 int
 mpc_exp2 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
 {
-  mpc_t two;
-  int ret;
-  mpc_init2 (two, MPFR_PREC_MIN); // 1 bit is enough to store 2 exactly
-  mpc_set_ui (two, 2, MPC_RNDNN);
-  ret = mpc_pow (rop, two, op, rnd);
-  mpc_clear (two);
-  return ret;
+   return mpc_exp_base (rop, op, 2, rnd);
 }
@@ -0,0 +1,275 @@
+/* mpc_expm1 -- exponential of a complex number minus one.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+int
+mpc_expm1 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+  mpfr_t m, e, s, c, t;
+  mpfr_prec_t prec;
+  mpfr_exp_t err_re, err_im;
+  int loop = 0, tiny_re = 0, inex, inex_re, inex_im;
+  int saved_underflow, saved_overflow;
+  mpfr_exp_t saved_emin, saved_emax;
+
+  if (!mpc_fin_p (op))
+    /* the special values are those of exp(op)-1, where the only finite
+       real part of exp(op) is a zero, for Re(op) = -inf */
+    {
+      inex = mpc_exp (rop, op, rnd);
+      if (mpfr_zero_p (mpc_realref (rop)))
+        mpfr_set_si (mpc_realref (rop), -1, MPFR_RNDN);
+      return inex;
+    }
+
+  if (mpfr_zero_p (mpc_imagref (op)))
+    /* expm1(x+i*0) = expm1(x) +i*0, where expm1(+-0) = +-0 */
+    {
+      inex_re = mpfr_expm1 (mpc_realref (rop), mpc_realref (op),
+                            MPC_RND_RE (rnd));
+      inex_im = mpfr_set (mpc_imagref (rop), mpc_imagref (op),
+                          MPC_RND_IM (rnd));
+      return MPC_INEX (inex_re, inex_im);
+    }
+
+  saved_emin = mpfr_get_emin ();
+  saved_emax = mpfr_get_emax ();
+  mpfr_set_emin (mpfr_get_emin_min ());
+  mpfr_set_emax (mpfr_get_emax_max ());
+
+  if (mpfr_zero_p (mpc_realref (op)))
+    {
+      /* For x = 0 and tiny y, the real part cos (y) - 1 = -y^2/2 + d with
+         0 < d < y^4/24 would make the Ziv loop below run up to a precision
+         of about -2 Exp (y). With h = -y^2/2, which is exact with
+         prec >= 2 prec (y) bits, and Exp (y) <= -prec/2, we have
+         d < 2^(Exp (h) - prec - 1), so that cos (y) - 1 rounds as
+         h + 2^(Exp (h) - prec - 1), the next number above h with prec + 1
+         bits, when prec > PREC_RE(rop). */
+      prec = MPC_MAX (2 * mpfr_get_prec (mpc_imagref (op)),
+                      MPC_PREC_RE (rop) + 2);
+      if (mpfr_get_exp (mpc_imagref (op)) <= - (mpfr_exp_t) (prec / 2))
+        {
+          mpc_tmp_fr_init2 (t, prec + 1);
+          /* inex != 0 if y^2/2 underflows */
+          inex = mpfr_sqr (t, mpc_imagref (op), MPFR_RNDN);
+          inex |= mpfr_div_2ui (t, t, 1, MPFR_RNDN);
+          if (inex == 0)
+            {
+              mpfr_neg (t, t, MPFR_RNDN);
+              mpfr_nextabove (t);
+              inex_im = mpfr_sin (mpc_imagref (rop), mpc_imagref (op),
+                                  MPC_RND_IM (rnd));
+              inex_re = mpfr_set (mpc_realref (rop), t, MPC_RND_RE (rnd));
+            }
+          mpc_tmp_fr_clear (t);
+          if (inex == 0)
+            goto end;
+        }
+    }
+
+  /* from now on, x = Re(op) is finite and y = Im(op) is a regular number.
+     With s = sin (y), c = cos (y), e = exp (x), m = expm1 (x) and
+     q = 1 - c, which is computed as s^2 / (1 + c) for c > 0 to avoid
+     cancellation, we have
+       expm1 (op) = m - q e + i * s e,
+     which suffers from cancellation only when the real part itself is
+     small compared to m and q e. */
+  prec = MPC_MAX_PREC (rop);
+  prec += mpc_ceil_log2 (prec) + 8;
+  mpc_tmp_fr_init2 (m, prec);
+  mpc_tmp_fr_init2 (e, prec);
+  mpc_tmp_fr_init2 (s, prec);
+  mpc_tmp_fr_init2 (c, prec);
+  mpc_tmp_fr_init2 (t, prec);
+
+  saved_underflow = mpfr_underflow_p ();
+  saved_overflow = mpfr_overflow_p ();
+
+  for (;;)
+    {
+      mpfr_clear_overflow ();
+      mpfr_clear_underflow ();
+      /* m and e have errors of at most 2^(Exp (m) - prec) and relative
+         errors of at most 2^(2 - prec); for x >= -1, we have e >= 1/e
+         and m >= 1/e - 1, and for x < -1, m = o(e - 1) with e < 1/e
+         does not suffer from cancellation. */
+      if (mpfr_zero_p (mpc_realref (op)))
+        {
+          mpfr_set_ui (m, 0, MPFR_RNDN);
+          mpfr_set_ui (e, 1, MPFR_RNDN);
+        }
+      else if (mpfr_cmp_si (mpc_realref (op), -1) >= 0)
+        {
+          mpfr_expm1 (m, mpc_realref (op), MPFR_RNDN);
+          mpfr_add_ui (e, m, 1, MPFR_RNDN);
+        }
+      else
+        {
+          mpfr_exp (e, mpc_realref (op), MPFR_RNDN);
+          mpfr_sub_ui (m, e, 1, MPFR_RNDN);
+        }
+      if (mpfr_inf_p (e) || mpfr_zero_p (e))
+        break;
+      /* for exp (x) < 2^(-PREC_RE(rop) - 2), the real part
+         -1 + exp (x) cos (y) rounds as -1 + tiny with the sign of cos (y),
+         which the loop could not decide */
+      tiny_re = (mpfr_get_exp (e) < - MPC_PREC_RE (rop) - 1);
+
+      mpfr_sin_cos (s, c, mpc_imagref (op), MPFR_RNDN);
+
+      /* Re = o(m - o(q e)): q = o(o(s^2) / o(1 + c)) for c > 0 and
+         q = o(1 - c) otherwise has a relative error of at most
+         6.1 * 2^(-prec), so that o(q e) has a relative error of at most
+         11.2 * 2^(-prec), and the error on Re is at most
+         2^(Exp (m) - prec) + 2^(Exp (o(q e)) + 4 - prec) + 1/2 ulp (Re). */
+      if (!tiny_re)
+        {
+          if (mpfr_sgn (c) > 0)
+            {
+              mpfr_add_ui (t, c, 1, MPFR_RNDN);
+              mpfr_sqr (c, s, MPFR_RNDN);
+              mpfr_div (c, c, t, MPFR_RNDN);
+            }
+          else
+            mpfr_ui_sub (c, 1, c, MPFR_RNDN);
+          mpfr_mul (c, c, e, MPFR_RNDN);
+          mpfr_sub (t, m, c, MPFR_RNDN);
+        }
+
+      /* Im = o(s e), whose relative error is at most 6.1 * 2^(-prec), so
+         that the error is at most 2^(Exp + 3 - prec). */
+      mpfr_mul (s, s, e, MPFR_RNDN);
+      err_im = 3;
+
+      if (mpfr_overflow_p () || mpfr_underflow_p ())
+        break;
+      if (tiny_re)
+        {
+          err_re = 0;
+          if (mpfr_can_round (s, prec - err_im, MPFR_RNDN, MPFR_RNDZ,
+                  MPC_PREC_IM (rop) + (MPC_RND_IM (rnd) == MPFR_RNDN)))
+            break;
+        }
+      else if (!mpfr_zero_p (t))
+        {
+          err_re = mpfr_get_exp (c) + 4;
+          if (!mpfr_zero_p (m))
+            err_re = MPC_MAX (err_re, mpfr_get_exp (m));
+          err_re = MPC_MAX (err_re, mpfr_get_exp (t) - 1) + 2
+                   - mpfr_get_exp (t);
+          if (mpfr_can_round (t, prec - err_re, MPFR_RNDN, MPFR_RNDZ,
+                  MPC_PREC_RE (rop) + (MPC_RND_RE (rnd) == MPFR_RNDN))
+              && mpfr_can_round (s, prec - err_im, MPFR_RNDN, MPFR_RNDZ,
+                  MPC_PREC_IM (rop) + (MPC_RND_IM (rnd) == MPFR_RNDN)))
+            break;
+        }
+      else
+        /* complete cancellation; the real part cannot be zero for y != 0,
+           since e^x cos (y) = 1 has no solution with rational x and y */
+        err_re = prec / 2;
+
+      /* the first time, add the number of lost bits */
+      if (++loop == 1)
+        prec += MPC_MAX (err_re, err_im);
+      else
+        prec += prec / 2;
+      mpfr_set_prec (m, prec);
+      mpfr_set_prec (e, prec);
+      mpfr_set_prec (s, prec);
+      mpfr_set_prec (c, prec);
+      mpfr_set_prec (t, prec);
+    }
+
+  if (mpfr_inf_p (e))
+    {
+      /* exp (x) overflows even in the extended exponent range; then
+         expm1 (op) is +-inf +-i*inf, where the signs are those of cos (y)
+         and sin (y) */
+      mpfr_set_prec (s, 2);
+      mpfr_set_prec (c, 2);
+      mpfr_sin_cos (s, c, mpc_imagref (op), MPFR_RNDN);
+      mpfr_set_inf (mpc_realref (rop), mpfr_sgn (c));
+      mpfr_set_inf (mpc_imagref (rop), mpfr_sgn (s));
+      inex_re = mpc_fix_inf (mpc_realref (rop), MPC_RND_RE (rnd));
+      inex_im = mpc_fix_inf (mpc_imagref (rop), MPC_RND_IM (rnd));
+    }
+  else
+    {
+      if (mpfr_zero_p (e) || tiny_re)
+        {
+          /* Re = -1 + exp (x) cos (y), where |exp (x) cos (y)| is less than
+             2^(Exp (e) - 1), and less than half an ulp of -1; so it may be
+             replaced by 2^(Exp (e) - 1), or by 2^(emin_min - 1) if exp (x)
+             underflows, with the sign of cos (y). */
+          mpfr_set_prec (t, 2);
+          mpfr_cos (t, mpc_imagref (op), MPFR_RNDN);
+          mpfr_set_si_2exp (t, mpfr_sgn (t),
+                            (mpfr_zero_p (e) ? mpfr_get_emin_min ()
+                                             : mpfr_get_exp (e)) - 1,
+                            MPFR_RNDN);
+          mpfr_set_si (m, -1, MPFR_RNDN);
+          inex_re = mpfr_add (mpc_realref (rop), m, t, MPC_RND_RE (rnd));
+        }
+      else
+        inex_re = mpfr_set (mpc_realref (rop), t, MPC_RND_RE (rnd));
+      if (mpfr_zero_p (e))
+        {
+          /* Im underflows with the sign of sin (y) */
+          mpfr_set_prec (s, 2);
+          mpfr_sin (s, mpc_imagref (op), MPFR_RNDN);
+          mpfr_set_zero (mpc_imagref (rop), mpfr_sgn (s));
+          inex_im = -mpfr_sgn (s);
+        }
+      else
+        inex_im = mpfr_set (mpc_imagref (rop), s, MPC_RND_IM (rnd));
+      /* as in mpc_exp, the parts that overflow or underflow in the
+         extended exponent range are not rounded */
+      if (mpfr_inf_p (mpc_realref (rop)))
+        inex_re = mpc_fix_inf (mpc_realref (rop), MPC_RND_RE (rnd));
+      else if (mpfr_zero_p (mpc_realref (rop)))
+        inex_re = mpc_fix_zero (mpc_realref (rop), MPC_RND_RE (rnd));
+      if (mpfr_inf_p (mpc_imagref (rop)))
+        inex_im = mpc_fix_inf (mpc_imagref (rop), MPC_RND_IM (rnd));
+      else if (mpfr_zero_p (mpc_imagref (rop)))
+        inex_im = mpc_fix_zero (mpc_imagref (rop), MPC_RND_IM (rnd));
+    }
+
+  mpc_tmp_fr_clear (t);
+  mpc_tmp_fr_clear (c);
+  mpc_tmp_fr_clear (s);
+  mpc_tmp_fr_clear (e);
+  mpc_tmp_fr_clear (m);
+
+  if (saved_underflow)
+    mpfr_set_underflow ();
+  if (saved_overflow)
+    mpfr_set_overflow ();
+
+ end:
+  /* restore the exponent range, and check the range of results */
+  mpfr_set_emin (saved_emin);
+  mpfr_set_emax (saved_emax);
+  inex_re = mpfr_check_range (mpc_realref (rop), inex_re, MPC_RND_RE (rnd));
+  inex_im = mpfr_check_range (mpc_imagref (rop), inex_im, MPC_RND_IM (rnd));
+
+  return MPC_INEX (inex_re, inex_im);
+}
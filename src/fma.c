@@ -1,6 +1,6 @@
 /* mpc_fma -- Fused multiply-add of three complex numbers
 
-Copyright (C) 2011, 2012, 2022 INRIA
+Copyright (C) 2011, 2012, 2022, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -72,6 +72,9 @@ mpc_fma (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
   if (mpc_fin_p (a) == 0 || mpc_fin_p (b) == 0 || mpc_fin_p (c) == 0)
     return mpc_fma_naive (r, a, b, c, rnd);
 
+  if (mpc_fma_limbs (r, a, b, c, rnd, &inex))
+    return inex;
+
   pre = mpfr_get_prec (mpc_realref(r));
   pim = mpfr_get_prec (mpc_imagref(r));
   wpre = pre + mpc_ceil_log2 (pre) + 10;
@@ -0,0 +1,101 @@
+/* mpc_fmma, mpc_fmms -- Fused multiply-multiply-add and -subtract of
+   four complex numbers
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* r <- a*b + c*d if neg is zero, r <- a*b - c*d otherwise; as in
+   mpc_fma_naive, the eight products are computed exactly, and each part
+   of the result is obtained by a single call to mpfr_sum, which also
+   deals with the special values. */
+static int
+mpc_fmma_naive (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c,
+   mpc_srcptr d, int neg, mpc_rnd_t rnd)
+{
+  mpfr_t p [8];
+  mpfr_ptr sum [4];
+  int i, inex_re, inex_im;
+
+  mpfr_init2 (p[0], MPC_PREC_RE (a) + MPC_PREC_RE (b));
+  mpfr_init2 (p[1], MPC_PREC_IM (a) + MPC_PREC_IM (b));
+  mpfr_init2 (p[2], MPC_PREC_RE (c) + MPC_PREC_RE (d));
+  mpfr_init2 (p[3], MPC_PREC_IM (c) + MPC_PREC_IM (d));
+  mpfr_init2 (p[4], MPC_PREC_RE (a) + MPC_PREC_IM (b));
+  mpfr_init2 (p[5], MPC_PREC_IM (a) + MPC_PREC_RE (b));
+  mpfr_init2 (p[6], MPC_PREC_RE (c) + MPC_PREC_IM (d));
+  mpfr_init2 (p[7], MPC_PREC_IM (c) + MPC_PREC_RE (d));
+
+  /* all products are exact */
+  mpfr_mul (p[0], mpc_realref (a), mpc_realref (b), MPFR_RNDZ);
+  mpfr_mul (p[1], mpc_imagref (a), mpc_imagref (b), MPFR_RNDZ);
+  mpfr_neg (p[1], p[1], MPFR_RNDZ);
+  mpfr_mul (p[2], mpc_realref (c), mpc_realref (d), MPFR_RNDZ);
+  mpfr_mul (p[3], mpc_imagref (c), mpc_imagref (d), MPFR_RNDZ);
+  mpfr_neg (p[3], p[3], MPFR_RNDZ);
+  mpfr_mul (p[4], mpc_realref (a), mpc_imagref (b), MPFR_RNDZ);
+  mpfr_mul (p[5], mpc_imagref (a), mpc_realref (b), MPFR_RNDZ);
+  mpfr_mul (p[6], mpc_realref (c), mpc_imagref (d), MPFR_RNDZ);
+  mpfr_mul (p[7], mpc_imagref (c), mpc_realref (d), MPFR_RNDZ);
+  if (neg)
+    {
+      mpfr_neg (p[2], p[2], MPFR_RNDZ);
+      mpfr_neg (p[3], p[3], MPFR_RNDZ);
+      mpfr_neg (p[6], p[6], MPFR_RNDZ);
+      mpfr_neg (p[7], p[7], MPFR_RNDZ);
+    }
+
+  sum [0] = p[0];
+  sum [1] = p[1];
+  sum [2] = p[2];
+  sum [3] = p[3];
+  inex_re = mpfr_sum (mpc_realref (r), sum, 4, MPC_RND_RE (rnd));
+  sum [0] = p[4];
+  sum [1] = p[5];
+  sum [2] = p[6];
+  sum [3] = p[7];
+  inex_im = mpfr_sum (mpc_imagref (r), sum, 4, MPC_RND_IM (rnd));
+
+  for (i = 0; i < 8; i++)
+    mpfr_clear (p[i]);
+
+  return MPC_INEX(inex_re, inex_im);
+}
+
+int
+mpc_fmma (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c,
+   mpc_srcptr d, mpc_rnd_t rnd)
+{
+  int inex;
+
+  if (mpc_fmma_limbs (r, a, b, c, d, 0, rnd, &inex))
+    return inex;
+  return mpc_fmma_naive (r, a, b, c, d, 0, rnd);
+}
+
+int
+mpc_fmms (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c,
+   mpc_srcptr d, mpc_rnd_t rnd)
+{
+  int inex;
+
+  if (mpc_fmma_limbs (r, a, b, c, d, 1, rnd, &inex))
+    return inex;
+  return mpc_fmma_naive (r, a, b, c, d, 1, rnd);
+}
@@ -0,0 +1,492 @@
+/* fsum -- Exact sums of real numbers.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* An exact sum s is a superaccumulator holding the exact value of the
+   finite non-zero summands added so far as the integer of s->n limbs
+   s->d in two's complement, least significant limb first, multiplied by
+   2^(s->e), where s->e is a multiple of GMP_NUMB_BITS. The window of
+   limbs grows downwards to the least significant bit of the summands and
+   upwards to the most significant bit of the partial sums, plus one limb
+   which is always a sign extension of the limb below it; so its size does
+   not depend on the number of summands, and adding a summand of n limbs
+   costs O(n) operations plus a rare carry propagation. The special
+   summands are recorded in s->flags, so that mpc_fsum_get returns the
+   same result as mpfr_sum on all summands.
+   A summand which would make the window longer than FSUM_MAX_LIMBS limbs
+   and grow it by more than its own size, as 1 after 2^(2^29), goes to
+   one of the s->nfar further windows s->far [i], which are exact sums
+   without flags or further windows of their own, and to a new one if it
+   does not fit into any of them either. The value of s is the sum of
+   all windows; so the memory is bounded in terms of the sizes of the
+   summands and of the number of clusters of their exponents, instead of
+   their span. */
+
+#define FSUM_NAN      1
+#define FSUM_POS_INF  2
+#define FSUM_NEG_INF  4
+#define FSUM_POS_ZERO 8
+#define FSUM_NEG_ZERO 16
+#define FSUM_NONZERO  32
+
+/* number of limbs of the magnitude of the sum that mpc_fsum_get negates
+   on the stack */
+#define FSUM_STACK_LIMBS 32
+
+/* number of limbs up to which a window may grow to absorb any summand */
+#define FSUM_MAX_LIMBS 1024
+
+#define LIMB_HIGHBIT ((mp_limb_t) 1 << (GMP_NUMB_BITS - 1))
+/* the limb filled with the sign bit of l */
+#define LIMB_SIGN(l) ((l) & LIMB_HIGHBIT ? ~ (mp_limb_t) 0 : 0)
+
+void
+mpc_fsum_init (__mpc_fsum_struct *s)
+{
+   s->d = NULL;
+   s->n = 0;
+   s->alloc = 0;
+   s->e = 0;
+   s->flags = 0;
+   s->far = NULL;
+   s->nfar = 0;
+   s->allocfar = 0;
+}
+
+void
+mpc_fsum_clear (__mpc_fsum_struct *s)
+{
+   void (*freefunc) (void *, size_t);
+   mp_size_t i;
+
+   mp_get_memory_functions (NULL, NULL, &freefunc);
+   for (i = 0; i < s->nfar; i++)
+      mpc_fsum_clear (s->far + i);
+   if (s->allocfar != 0)
+      (*freefunc) (s->far, s->allocfar * sizeof (__mpc_fsum_struct));
+   if (s->alloc != 0)
+      (*freefunc) (s->d, s->alloc * sizeof (mp_limb_t));
+}
+
+static void
+fsum_reserve (__mpc_fsum_struct *s, mp_size_t n)
+   /* Make room for n limbs in s->d. */
+{
+   void * (*reallocfunc) (void *, size_t, size_t);
+   mp_size_t alloc;
+
+   if (n > s->alloc) {
+      alloc = MPC_MAX (n, 2 * s->alloc);
+      mp_get_memory_functions (NULL, &reallocfunc, NULL);
+      s->d = (mp_limb_t *) (*reallocfunc) (s->d,
+         s->alloc * sizeof (mp_limb_t), alloc * sizeof (mp_limb_t));
+      s->alloc = alloc;
+   }
+}
+
+static void
+fsum_extend (__mpc_fsum_struct *s, mpfr_exp_t lo, mpfr_exp_t hi)
+   /* Extend the window of s such that it contains the bits of weight
+      2^lo to 2^(hi-1) of a number, which may be added to s without
+      overflowing its top limb. */
+{
+   mp_size_t k, i;
+   mp_limb_t sign;
+
+   /* align lo downwards on a limb boundary */
+   lo -= ((lo % GMP_NUMB_BITS) + GMP_NUMB_BITS) % GMP_NUMB_BITS;
+   if (s->n == 0) {
+      fsum_reserve (s, 2);
+      s->d [0] = 0;
+      s->d [1] = 0;
+      s->n = 2;
+      s->e = lo;
+   }
+   else if (lo < s->e) {
+      k = (mp_size_t) ((s->e - lo) / GMP_NUMB_BITS);
+      fsum_reserve (s, s->n + k);
+      for (i = s->n - 1; i >= 0; i--)
+         s->d [i + k] = s->d [i];
+      for (i = 0; i < k; i++)
+         s->d [i] = 0;
+      s->n += k;
+      s->e = lo;
+   }
+
+   /* the number is less than 2^hi in absolute value, and the sum
+      of n limbs less than 2^((n-1)*GMP_NUMB_BITS-1) */
+   if (hi - s->e > (mpfr_exp_t) (s->n - 1) * GMP_NUMB_BITS - 1) {
+      k = (mp_size_t) ((hi - s->e) / GMP_NUMB_BITS) + 2;
+      fsum_reserve (s, k);
+      sign = LIMB_SIGN (s->d [s->n - 1]);
+      for (i = s->n; i < k; i++)
+         s->d [i] = sign;
+      s->n = k;
+   }
+}
+
+static void
+fsum_normalise (__mpc_fsum_struct *s)
+   /* Restore the invariant that the top limb is a sign extension. */
+{
+   mp_limb_t sign = LIMB_SIGN (s->d [s->n - 2]);
+
+   if (s->d [s->n - 1] != sign) {
+      fsum_reserve (s, s->n + 1);
+      s->d [s->n] = LIMB_SIGN (s->d [s->n - 1]);
+      s->n++;
+   }
+}
+
+static int
+fsum_fits (const __mpc_fsum_struct *s, mpfr_exp_t lo, mpfr_exp_t hi,
+           mp_size_t n)
+   /* Return non-zero if the window of s may be extended to the bits of
+      weight 2^lo to 2^(hi-1) of a number of n limbs, that is, if it is
+      empty, or if it then has at most FSUM_MAX_LIMBS limbs, or if it grows
+      by at most n + 2 limbs. */
+{
+   mpfr_exp_t bot, top;
+   mpfr_uexp_t span;
+
+   if (s->n == 0)
+      return 1;
+   bot = MPC_MIN (s->e, lo);
+   top = MPC_MAX (s->e + (mpfr_exp_t) s->n * GMP_NUMB_BITS,
+                  hi + 2 * GMP_NUMB_BITS);
+   /* top - bot may not fit into an mpfr_exp_t */
+   span = ((mpfr_uexp_t) top - (mpfr_uexp_t) bot) / GMP_NUMB_BITS;
+   return span <= FSUM_MAX_LIMBS || span - s->n <= (mpfr_uexp_t) n + 2;
+}
+
+static __mpc_fsum_struct *
+fsum_window (__mpc_fsum_struct *s, mpfr_exp_t lo, mpfr_exp_t hi,
+             mp_size_t n)
+   /* Return the window of s into which a number of n limbs with bits of
+      weight 2^lo to 2^(hi-1) is to be added, creating it if need be. */
+{
+   void * (*reallocfunc) (void *, size_t, size_t);
+   mp_size_t i, alloc;
+
+   if (fsum_fits (s, lo, hi, n))
+      return s;
+   for (i = 0; i < s->nfar; i++)
+      if (fsum_fits (s->far + i, lo, hi, n))
+         return s->far + i;
+
+   if (s->nfar == s->allocfar) {
+      alloc = (s->allocfar == 0 ? 2 : 2 * s->allocfar);
+      mp_get_memory_functions (NULL, &reallocfunc, NULL);
+      s->far = (__mpc_fsum_struct *) (*reallocfunc) (s->far,
+         s->allocfar * sizeof (__mpc_fsum_struct),
+         alloc * sizeof (__mpc_fsum_struct));
+      s->allocfar = alloc;
+   }
+   mpc_fsum_init (s->far + s->nfar);
+   return s->far + s->nfar++;
+}
+
+static void
+fsum_add (__mpc_fsum_struct *s, mpfr_srcptr x)
+   /* Add the regular number x to the window s. */
+{
+   mp_size_t xn, q, i;
+   mpfr_exp_t lo;
+   const mp_limb_t *xp;
+   mp_limb_t *d, l, t, c;
+   int r;
+
+   xn = (mp_size_t) ((mpfr_get_prec (x) - 1) / GMP_NUMB_BITS + 1);
+   xp = (const mp_limb_t *) mpfr_custom_get_significand (x);
+   lo = mpfr_get_exp (x) - (mpfr_exp_t) xn * GMP_NUMB_BITS;
+   if (s->n == 0 || lo < s->e
+       || mpfr_get_exp (x) - s->e
+          > (mpfr_exp_t) (s->n - 1) * GMP_NUMB_BITS - 1)
+      fsum_extend (s, lo, mpfr_get_exp (x));
+
+   /* add or subtract the significand shifted by r bits at limb q */
+   q = (mp_size_t) ((lo - s->e) / GMP_NUMB_BITS);
+   r = (int) ((lo - s->e) % GMP_NUMB_BITS);
+   d = s->d + q;
+   c = 0;
+   if (!mpfr_signbit (x)) {
+      if (r == 0)
+         c = mpn_add_n (d, d, xp, xn);
+      else
+         for (i = 0; i <= xn; i++) {
+            l = (i < xn ? xp [i] << r : 0)
+                | (i > 0 ? xp [i - 1] >> (GMP_NUMB_BITS - r) : 0);
+            t = d [i] + c;
+            c = (t < c);
+            d [i] = t + l;
+            c += (d [i] < l);
+         }
+      for (i = (r == 0 ? xn : xn + 1); c != 0 && q + i < s->n; i++) {
+         d [i]++;
+         c = (d [i] == 0);
+      }
+   }
+   else {
+      if (r == 0)
+         c = mpn_sub_n (d, d, xp, xn);
+      else
+         for (i = 0; i <= xn; i++) {
+            l = (i < xn ? xp [i] << r : 0)
+                | (i > 0 ? xp [i - 1] >> (GMP_NUMB_BITS - r) : 0);
+            t = d [i];
+            d [i] = t - l - c;
+            c = (t < l) || (t == l && c);
+         }
+      for (i = (r == 0 ? xn : xn + 1); c != 0 && q + i < s->n; i++) {
+         c = (d [i] == 0);
+         d [i]--;
+      }
+   }
+   fsum_normalise (s);
+}
+
+void
+mpc_fsum_add (__mpc_fsum_struct *s, mpfr_srcptr x)
+{
+   mp_size_t xn;
+
+   if (mpfr_nan_p (x))
+      s->flags |= FSUM_NAN;
+   else if (mpfr_inf_p (x))
+      s->flags |= (mpfr_signbit (x) ? FSUM_NEG_INF : FSUM_POS_INF);
+   else if (mpfr_zero_p (x))
+      s->flags |= (mpfr_signbit (x) ? FSUM_NEG_ZERO : FSUM_POS_ZERO);
+   else {
+      s->flags |= FSUM_NONZERO;
+      xn = (mp_size_t) ((mpfr_get_prec (x) - 1) / GMP_NUMB_BITS + 1);
+      fsum_add (fsum_window (s,
+                   mpfr_get_exp (x) - (mpfr_exp_t) xn * GMP_NUMB_BITS,
+                   mpfr_get_exp (x), xn),
+                x);
+   }
+}
+
+static void
+fsum_merge (__mpc_fsum_struct *s, const __mpc_fsum_struct *t)
+   /* Add the non-empty window t to the window s. */
+{
+   mp_size_t q, i, tn;
+   mp_limb_t sign, c, u;
+
+   tn = t->n;
+   fsum_extend (s, t->e,
+                t->e + (mpfr_exp_t) (tn - 1) * GMP_NUMB_BITS);
+   q = (mp_size_t) ((t->e - s->e) / GMP_NUMB_BITS);
+   c = mpn_add_n (s->d + q, s->d + q, t->d, tn);
+   /* add the sign extension of t to the limbs above */
+   sign = LIMB_SIGN (t->d [tn - 1]);
+   for (i = q + tn; i < s->n; i++) {
+      u = s->d [i] + c;
+      c = (u < c);
+      s->d [i] = u + sign;
+      c += (s->d [i] < sign);
+   }
+   fsum_normalise (s);
+}
+
+static void
+fsum_merge_window (__mpc_fsum_struct *s, const __mpc_fsum_struct *t)
+   /* Add the window t, which is not one of the windows of s, to s. */
+{
+   mpfr_exp_t hi;
+
+   if (t->n != 0) {
+      hi = t->e + (mpfr_exp_t) (t->n - 1) * GMP_NUMB_BITS;
+      fsum_merge (fsum_window (s, t->e, hi, t->n), t);
+   }
+}
+
+/* s <- s + t, as if all summands of t had been added to s. */
+void
+mpc_fsum_merge (__mpc_fsum_struct *s, const __mpc_fsum_struct *t)
+{
+   mp_size_t i;
+
+   if (s == t) {
+      /* the top limbs being sign extensions, doubling does not
+         overflow */
+      if (s->n != 0) {
+         mpn_lshift (s->d, s->d, s->n, 1);
+         fsum_normalise (s);
+      }
+      for (i = 0; i < s->nfar; i++) {
+         mpn_lshift (s->far [i].d, s->far [i].d, s->far [i].n, 1);
+         fsum_normalise (s->far + i);
+      }
+      return;
+   }
+
+   s->flags |= t->flags;
+   fsum_merge_window (s, t);
+   for (i = 0; i < t->nfar; i++)
+      fsum_merge_window (s, t->far + i);
+}
+
+static int
+fsum_zero_p (const __mpc_fsum_struct *s)
+   /* Return non-zero if the window s has value 0. */
+{
+   mp_size_t i;
+
+   for (i = 0; i < s->n; i++)
+      if (s->d [i] != 0)
+         return 0;
+   return 1;
+}
+
+static int
+fsum_get (mpfr_ptr rop, const __mpc_fsum_struct *s, mpfr_rnd_t rnd)
+   /* Set rop to the value of the window s, which is not 0, rounded
+      according to rnd, and return the ternary value. */
+{
+   mp_limb_t buf [FSUM_STACK_LIMBS];
+   mp_limb_t *p;
+   mp_size_t bot, top, n;
+   mpz_t z;
+   void * (*allocfunc) (size_t);
+   void (*freefunc) (void *, size_t);
+   int neg, inex;
+
+   for (bot = 0; s->d [bot] == 0; bot++);
+
+   /* the magnitude of the sum in p [0..top] */
+   n = s->n - bot;
+   neg = (s->d [s->n - 1] & LIMB_HIGHBIT) != 0;
+   if (neg) {
+      if (n <= FSUM_STACK_LIMBS)
+         p = buf;
+      else {
+         mp_get_memory_functions (&allocfunc, NULL, NULL);
+         p = (mp_limb_t *) (*allocfunc) (n * sizeof (mp_limb_t));
+      }
+      mpn_neg (p, s->d + bot, n);
+   }
+   else
+      p = s->d + bot;
+   for (top = n - 1; p [top] == 0; top--);
+
+   mpz_init2 (z, (mp_bitcnt_t) (top + 1) * GMP_NUMB_BITS);
+   mpz_import (z, (size_t) (top + 1), -1, sizeof (mp_limb_t), 0, 0, p);
+   if (neg)
+      mpz_neg (z, z);
+   inex = mpfr_set_z_2exp (rop, z,
+                           s->e + (mpfr_exp_t) bot * GMP_NUMB_BITS, rnd);
+   mpz_clear (z);
+
+   if (neg && n > FSUM_STACK_LIMBS) {
+      mp_get_memory_functions (NULL, NULL, &freefunc);
+      (*freefunc) (p, n * sizeof (mp_limb_t));
+   }
+
+   return inex;
+}
+
+/* Set rop to the sum s rounded according to rnd and return the ternary
+   value. */
+int
+mpc_fsum_get (mpfr_ptr rop, const __mpc_fsum_struct *s, mpfr_rnd_t rnd)
+{
+   const __mpc_fsum_struct *w;
+   mpfr_t *v;
+   mpfr_ptr *t;
+   mp_size_t i, k;
+   mpfr_exp_t saved_emin, saved_emax;
+   void * (*allocfunc) (size_t);
+   void (*freefunc) (void *, size_t);
+   int inex;
+
+   if ((s->flags & FSUM_NAN)
+       || ((s->flags & FSUM_POS_INF) && (s->flags & FSUM_NEG_INF))) {
+      mpfr_set_nan (rop);
+      return 0;
+   }
+   else if (s->flags & (FSUM_POS_INF | FSUM_NEG_INF)) {
+      mpfr_set_inf (rop, (s->flags & FSUM_POS_INF) ? +1 : -1);
+      return 0;
+   }
+
+   /* k is the number of non-zero windows, and w the last of them */
+   k = 0;
+   w = NULL;
+   if (!fsum_zero_p (s)) {
+      k++;
+      w = s;
+   }
+   for (i = 0; i < s->nfar; i++)
+      if (!fsum_zero_p (s->far + i)) {
+         k++;
+         w = s->far + i;
+      }
+
+   if (k == 0) {
+      /* as in IEEE 754, the sign of an exact zero is the common sign of
+         all summands if they are zeros of the same sign; otherwise it is
+         positive, except when rounding downwards; an empty sum is +0 as
+         in mpfr_sum */
+      if (s->flags == 0)
+         mpfr_set_zero (rop, +1);
+      else if (!(s->flags & FSUM_NONZERO) && (s->flags & FSUM_NEG_ZERO)
+          && !(s->flags & FSUM_POS_ZERO))
+         mpfr_set_zero (rop, -1);
+      else if (!(s->flags & FSUM_NONZERO) && (s->flags & FSUM_POS_ZERO)
+               && !(s->flags & FSUM_NEG_ZERO))
+         mpfr_set_zero (rop, +1);
+      else
+         mpfr_set_zero (rop, rnd == MPFR_RNDD ? -1 : +1);
+      return 0;
+   }
+   else if (k == 1)
+      return fsum_get (rop, w, rnd);
+
+   /* round the sum of the exact values of the windows with mpfr_sum, in
+      the extended exponent range in which they are representable */
+   saved_emin = mpfr_get_emin ();
+   saved_emax = mpfr_get_emax ();
+   mpfr_set_emin (mpfr_get_emin_min ());
+   mpfr_set_emax (mpfr_get_emax_max ());
+   mp_get_memory_functions (&allocfunc, NULL, &freefunc);
+   v = (mpfr_t *) (*allocfunc) (k * sizeof (mpfr_t));
+   t = (mpfr_ptr *) (*allocfunc) (k * sizeof (mpfr_ptr));
+   k = 0;
+   for (i = -1; i < s->nfar; i++) {
+      w = (i < 0 ? s : s->far + i);
+      if (!fsum_zero_p (w)) {
+         mpfr_init2 (v [k], (mpfr_prec_t) w->n * GMP_NUMB_BITS);
+         fsum_get (v [k], w, MPFR_RNDN); /* exact */
+         t [k] = v [k];
+         k++;
+      }
+   }
+   inex = mpfr_sum (rop, t, (unsigned long) k, rnd);
+   for (i = 0; i < k; i++)
+      mpfr_clear (v [i]);
+   (*freefunc) (t, k * sizeof (mpfr_ptr));
+   (*freefunc) (v, k * sizeof (mpfr_t));
+   mpfr_set_emin (saved_emin);
+   mpfr_set_emax (saved_emax);
+
+   return mpfr_check_range (rop, inex, rnd);
+}
@@ -0,0 +1,54 @@
+/* mpc_get_polar -- Modulus and argument of a complex number.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* the real part of rnd is used for the modulus, its imaginary part for the
+   argument */
+int
+mpc_get_polar (mpfr_ptr r, mpfr_ptr theta, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   mpc_t z;
+   int inex, inex_r, inex_theta;
+
+   if (r == mpc_realref (op) || r == mpc_imagref (op)
+       || theta == mpc_realref (op) || theta == mpc_imagref (op)) {
+      mpc_init3 (z, MPC_PREC_RE (op), MPC_PREC_IM (op));
+      mpc_set (z, op, MPC_RNDNN);
+      inex = mpc_get_polar (r, theta, z, rnd);
+      mpc_clear (z);
+      return inex;
+   }
+
+   /* For small precisions, both results are first obtained from a single
+      conversion of op to double-double numbers; otherwise, and for
+      special values and numbers on the axes, they are computed as by
+      mpc_abs and mpc_arg. */
+   if (mpfr_regular_p (mpc_realref (op)) && mpfr_regular_p (mpc_imagref (op))
+       && mpc_get_polar_dd (r, theta, op, rnd, &inex))
+      return inex;
+
+   inex_r = mpfr_hypot (r, mpc_realref (op), mpc_imagref (op),
+                        MPC_RND_RE (rnd));
+   inex_theta = mpfr_atan2 (theta, mpc_imagref (op), mpc_realref (op),
+                            MPC_RND_IM (rnd));
+
+   return MPC_INEX (inex_r, inex_theta);
+}
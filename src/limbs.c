@@ -0,0 +1,507 @@
+/* limbs -- Fixed-size kernels for operands of one or two limbs.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* The functions mpc_xxx_limbs of this file compute mpc_mul, mpc_sqr,
+   mpc_norm, mpc_fma, mpc_fmma and mpc_fmms when all operands and results
+   have a precision of at most LIMBS_MAX limbs. They work directly on the
+   significands: the products are computed exactly, then added with their
+   signs in a fixed-point accumulator of at most LIMBS_ACC limbs, from
+   which the result is rounded correctly. Terms that are too small to fit
+   into the accumulator are replaced by a sticky bit.
+   The functions return 1 and store the ternary value in *inex if they
+   could compute the result; they return 0 without changing rop if the
+   result is an exact zero, if it would underflow or overflow, or if a
+   cancellation prevents the correct rounding from the accumulator, and
+   the caller then falls back to the generic algorithm. The operands of
+   mpc_mul_limbs, mpc_sqr_limbs and mpc_norm_limbs must be regular
+   numbers; mpc_fma_limbs and mpc_fmma_limbs check their operands
+   themselves. */
+
+#define LIMBS_MAX 2
+
+/* the accumulator holds the largest product and LIMBS_ACC - 2*LIMBS_MAX
+   additional limbs: below it for the alignment of the smaller terms and
+   above it for the carries and the sign in two's complement */
+#define LIMBS_ACC 7
+
+#define LIMB_HIGHBIT ((mp_limb_t) 1 << (GMP_NUMB_BITS - 1))
+#define LIMB_SIZE(x) \
+   ((mp_size_t) ((mpfr_get_prec (x) - 1) / GMP_NUMB_BITS + 1))
+
+#if defined (__SIZEOF_INT128__) && GMP_NUMB_BITS == 64
+#define UMUL_PPMM(ph, pl, a, b)                                         \
+   do {                                                                 \
+      unsigned __int128 _p = (unsigned __int128) (a) * (b);             \
+      (ph) = (mp_limb_t) (_p >> 64);                                    \
+      (pl) = (mp_limb_t) _p;                                            \
+   } while (0)
+#else
+#define UMUL_PPMM(ph, pl, a, b)                                         \
+   do {                                                                 \
+      mp_limb_t _a = (a);                                               \
+      (ph) = mpn_mul_1 (&(pl), &_a, 1, (b));                            \
+   } while (0)
+#endif
+
+#if defined (__GNUC__) && GMP_NUMB_BITS == 64
+#define COUNT_LEADING_ZEROS(c, x) ((c) = __builtin_clzll (x))
+#else
+#define COUNT_LEADING_ZEROS(c, x)                                       \
+   do {                                                                 \
+      mp_limb_t _x = (x);                                               \
+      for ((c) = 0; !(_x & LIMB_HIGHBIT); (c)++)                        \
+         _x <<= 1;                                                      \
+   } while (0)
+#endif
+
+/* A term is the number (-1)^neg * 0.d * 2^exp, where the significand d
+   of n limbs is stored with the least significant limb first. */
+typedef struct {
+   mp_limb_t d [2 * LIMBS_MAX];
+   mp_size_t n;
+   int neg;
+   mpfr_exp_t exp;
+} term_t;
+
+/* A result rounded to at most LIMBS_MAX limbs. */
+typedef struct {
+   mp_limb_t d [LIMBS_MAX];
+   int neg;
+   mpfr_exp_t exp;
+   int inex;
+} result_t;
+
+
+static int
+limbs_p (mpfr_srcptr x)
+{
+   return mpfr_get_prec (x) <= LIMBS_MAX * GMP_NUMB_BITS;
+}
+
+static void
+term_mul (term_t *t, mpfr_srcptr x, mpfr_srcptr y, int neg)
+   /* Set t to the exact product x*y, negated if neg is non-zero. */
+{
+   const mp_limb_t *xp = (const mp_limb_t *) mpfr_custom_get_significand (x);
+   const mp_limb_t *yp = (const mp_limb_t *) mpfr_custom_get_significand (y);
+   mp_size_t xn = LIMB_SIZE (x), yn = LIMB_SIZE (y);
+
+   if (xn == 1 && yn == 1)
+      UMUL_PPMM (t->d [1], t->d [0], xp [0], yp [0]);
+   else if (xn >= yn)
+      mpn_mul (t->d, xp, xn, yp, yn);
+   else
+      mpn_mul (t->d, yp, yn, xp, xn);
+   t->n = xn + yn;
+   t->neg = (mpfr_signbit (x) != mpfr_signbit (y)) ^ neg;
+   t->exp = mpfr_get_exp (x) + mpfr_get_exp (y);
+}
+
+static void
+term_set (term_t *t, mpfr_srcptr x)
+   /* Set t to x. */
+{
+   const mp_limb_t *xp = (const mp_limb_t *) mpfr_custom_get_significand (x);
+   mp_size_t i;
+
+   t->n = LIMB_SIZE (x);
+   for (i = 0; i < t->n; i++)
+      t->d [i] = xp [i];
+   t->neg = mpfr_signbit (x) != 0;
+   t->exp = mpfr_get_exp (x);
+}
+
+static int
+acc_add (mp_limb_t *acc, mp_size_t an, const term_t *t, int neg,
+   mpfr_exp_t e)
+   /* Add t, or subtract it if neg is non-zero, to the accumulator of an
+      limbs, in which the bit of weight 2^(e-1) is the most significant
+      bit of limb an - 2, with e >= t->exp; the sign of t is ignored.
+      Bits of t of weight less than the least significant bit
+      of the accumulator are truncated; if this happens, return 1 and let
+      the accumulator be the largest number below the exact sum, otherwise
+      return 0. */
+{
+   mpfr_uexp_t d = (mpfr_uexp_t) (e - t->exp);
+   mp_limb_t a, b, cy;
+   mp_size_t i, j, off;
+   int r, lost;
+
+   if (d >= (mpfr_uexp_t) (an - 1) * GMP_NUMB_BITS) {
+      /* t lies entirely below the accumulator */
+      off = - t->n;
+      r = 0;
+      lost = 1;
+   }
+   else {
+      /* limb j of t, shifted right by r bits, goes to limb off + j */
+      off = an - 1 - (mp_size_t) (d / GMP_NUMB_BITS) - t->n;
+      r = (int) (d % GMP_NUMB_BITS);
+      lost = 0;
+      for (j = 0; j < t->n && off + j < 0; j++)
+         lost |= (t->d [j] != 0);
+      if (r != 0 && off + j <= 0 && j < t->n)
+         lost |= (t->d [j] << (GMP_NUMB_BITS - r) != 0);
+   }
+
+   /* add or subtract the limbs b of the shifted term, starting with the
+      lowest one inside the accumulator */
+   cy = (neg ? lost : 0);
+   for (i = (off > 0 ? off - (r != 0) : 0); i < an; i++) {
+      j = i - off;
+      if (j >= t->n && cy == 0)
+         break;
+      b = (j >= 0 && j < t->n ? t->d [j] >> r : 0);
+      if (r != 0 && j + 1 >= 0 && j + 1 < t->n)
+         b |= t->d [j + 1] << (GMP_NUMB_BITS - r);
+      a = acc [i];
+      if (neg) {
+         /* subtracting the truncated term, and one more unit if it is
+            not exact, yields a lower bound */
+         acc [i] = a - b - cy;
+         cy = (a < b) | ((a == b) & cy);
+      }
+      else {
+         b += a;
+         acc [i] = b + cy;
+         cy = (b < a) | (acc [i] < cy);
+      }
+   }
+
+   return lost;
+}
+
+static int
+round_sum (result_t *res, const term_t *t, int n, mpfr_prec_t p,
+   mpfr_rnd_t rnd, mpfr_exp_t emin, mpfr_exp_t emax)
+   /* Round the sum of the n terms in t to precision p in the direction rnd
+      and store it in res; return 0 if this is not possible, see above,
+      where emin and emax are the bounds of the current exponent range. */
+{
+   mp_limb_t acc [LIMBS_ACC], st;
+   mpfr_exp_t e;
+   mp_size_t i, k, m, an, rn;
+   int lost = 0, c, sh, rb, up;
+
+   /* start with the term t [m] of largest exponent e, with its sign
+      factored out */
+   m = 0;
+   an = t [0].n;
+   for (i = 1; i < n; i++) {
+      if (t [i].exp > t [m].exp)
+         m = i;
+      if (t [i].n > an)
+         an = t [i].n;
+   }
+   e = t [m].exp;
+   an += LIMBS_ACC - 2 * LIMBS_MAX;
+   for (i = 0; i < LIMBS_ACC; i++)
+      acc [i] = 0;
+   for (i = 0; i < t [m].n; i++)
+      acc [an - 1 - t [m].n + i] = t [m].d [i];
+   for (i = 0; i < n; i++)
+      if (i != m)
+         lost += acc_add (acc, an, t + i, t [i].neg != t [m].neg, e);
+   if (lost > 1)
+      /* the truncation errors may add up to more than one unit */
+      return 0;
+
+   /* Now the exact sum, multiplied by (-1)^t[m].neg, is acc if lost is 0,
+      and lies in (acc, acc+1) otherwise; take its absolute value, for
+      which the same holds. */
+   res->neg = (acc [an - 1] & LIMB_HIGHBIT) != 0;
+   if (res->neg) {
+      /* -acc-1 is the one's complement of acc */
+      st = !lost;
+      for (i = 0; i < an; i++) {
+         acc [i] = ~acc [i] + st;
+         st &= (acc [i] == 0);
+      }
+   }
+   res->neg ^= t [m].neg;
+
+   for (k = an - 1; k >= 0 && acc [k] == 0; k--);
+   if (k < 0)
+      /* exact zero, or a complete cancellation of the larger terms */
+      return 0;
+   COUNT_LEADING_ZEROS (c, acc [k]);
+   /* the sum has (k+1)*GMP_NUMB_BITS - c bits in the accumulator, which
+      must include the rounding bit if the sum is not exact */
+   if (lost && (mpfr_prec_t) ((k + 1) * GMP_NUMB_BITS - c) <= p)
+      return 0;
+   res->exp = e - (an - 2 - k) * GMP_NUMB_BITS - c;
+
+   /* normalise the accumulator, keeping its k+1 non-zero limbs */
+   if (c != 0) {
+      for (i = k; i > 0; i--)
+         acc [i] = (acc [i] << c) | (acc [i - 1] >> (GMP_NUMB_BITS - c));
+      acc [0] <<= c;
+   }
+
+   /* split into the p-bit result, the rounding bit rb and the sticky
+      bits st */
+   rn = (mp_size_t) ((p - 1) / GMP_NUMB_BITS + 1);
+   for (i = 0; i < rn; i++)
+      res->d [i] = (k - rn + 1 + i >= 0 ? acc [k - rn + 1 + i] : 0);
+   sh = (int) (rn * GMP_NUMB_BITS - p);
+   st = lost;
+   i = k - rn;
+   if (sh != 0) {
+      rb = (res->d [0] >> (sh - 1)) & 1;
+      st |= res->d [0] & ((((mp_limb_t) 1) << (sh - 1)) - 1);
+      res->d [0] &= ~((((mp_limb_t) 1) << sh) - 1);
+   }
+   else if (i >= 0) {
+      rb = acc [i] >> (GMP_NUMB_BITS - 1);
+      st |= acc [i] << 1;
+      i--;
+   }
+   else
+      rb = 0;
+   for (; i >= 0; i--)
+      st |= acc [i];
+
+   if (!rb && !st)
+      res->inex = 0;
+   else {
+      if (rnd == MPFR_RNDN)
+         up = rb && (st || ((res->d [0] >> sh) & 1));
+      else if (rnd == MPFR_RNDZ)
+         up = 0;
+      else if (rnd == MPFR_RNDU)
+         up = !res->neg;
+      else if (rnd == MPFR_RNDD)
+         up = res->neg;
+      else
+         up = 1;
+      if (up && mpn_add_1 (res->d, res->d, rn, ((mp_limb_t) 1) << sh)) {
+         res->d [rn - 1] = LIMB_HIGHBIT;
+         res->exp++;
+      }
+      res->inex = (up != res->neg ? 1 : -1);
+   }
+
+   return res->exp >= emin && res->exp <= emax;
+}
+
+static int
+result_set (mpfr_ptr x, const result_t *res)
+   /* Set x to res, whose precision is that of x and whose exponent lies
+      in the current range, and return the ternary value. */
+{
+   mpfr_t r;
+
+   /* r shares the significand of res, and is copied exactly */
+   mpfr_custom_init_set (r,
+      res->neg ? - MPFR_REGULAR_KIND : MPFR_REGULAR_KIND,
+      res->exp, mpfr_get_prec (x), (void *) res->d);
+   mpfr_set (x, r, MPFR_RNDN);
+   if (res->inex != 0)
+      mpfr_set_inexflag ();
+   return res->inex;
+}
+
+
+int
+mpc_mul_limbs (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd,
+   int *inex)
+{
+   term_t t [2];
+   result_t re, im;
+   mpfr_exp_t emin, emax;
+   int inex_re, inex_im;
+
+   if (GMP_NAIL_BITS != 0
+       || !limbs_p (mpc_realref (rop)) || !limbs_p (mpc_imagref (rop))
+       || !limbs_p (mpc_realref (op1)) || !limbs_p (mpc_imagref (op1))
+       || !limbs_p (mpc_realref (op2)) || !limbs_p (mpc_imagref (op2)))
+      return 0;
+
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   term_mul (t, mpc_realref (op1), mpc_realref (op2), 0);
+   term_mul (t + 1, mpc_imagref (op1), mpc_imagref (op2), 1);
+   if (!round_sum (&re, t, 2, MPC_PREC_RE (rop), MPC_RND_RE (rnd),
+                   emin, emax))
+      return 0;
+   term_mul (t, mpc_realref (op1), mpc_imagref (op2), 0);
+   term_mul (t + 1, mpc_imagref (op1), mpc_realref (op2), 0);
+   if (!round_sum (&im, t, 2, MPC_PREC_IM (rop), MPC_RND_IM (rnd),
+                   emin, emax))
+      return 0;
+
+   inex_re = result_set (mpc_realref (rop), &re);
+   inex_im = result_set (mpc_imagref (rop), &im);
+   *inex = MPC_INEX (inex_re, inex_im);
+   return 1;
+}
+
+
+int
+mpc_sqr_limbs (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd, int *inex)
+{
+   term_t t [2];
+   result_t re, im;
+   mpfr_exp_t emin, emax;
+   int inex_re, inex_im;
+
+   if (GMP_NAIL_BITS != 0
+       || !limbs_p (mpc_realref (rop)) || !limbs_p (mpc_imagref (rop))
+       || !limbs_p (mpc_realref (op)) || !limbs_p (mpc_imagref (op)))
+      return 0;
+
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   term_mul (t, mpc_realref (op), mpc_realref (op), 0);
+   term_mul (t + 1, mpc_imagref (op), mpc_imagref (op), 1);
+   if (!round_sum (&re, t, 2, MPC_PREC_RE (rop), MPC_RND_RE (rnd),
+                   emin, emax))
+      return 0;
+   term_mul (t, mpc_realref (op), mpc_imagref (op), 0);
+   t [0].exp++;
+   if (!round_sum (&im, t, 1, MPC_PREC_IM (rop), MPC_RND_IM (rnd),
+                   emin, emax))
+      return 0;
+
+   inex_re = result_set (mpc_realref (rop), &re);
+   inex_im = result_set (mpc_imagref (rop), &im);
+   *inex = MPC_INEX (inex_re, inex_im);
+   return 1;
+}
+
+
+int
+mpc_norm_limbs (mpfr_ptr rop, mpc_srcptr op, mpfr_rnd_t rnd, int *inex)
+{
+   term_t t [2];
+   result_t res;
+   mpfr_exp_t emin, emax;
+
+   if (GMP_NAIL_BITS != 0 || !limbs_p (rop)
+       || !limbs_p (mpc_realref (op)) || !limbs_p (mpc_imagref (op)))
+      return 0;
+
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   term_mul (t, mpc_realref (op), mpc_realref (op), 0);
+   term_mul (t + 1, mpc_imagref (op), mpc_imagref (op), 0);
+   if (!round_sum (&res, t, 2, mpfr_get_prec (rop), rnd, emin, emax))
+      return 0;
+
+   *inex = result_set (rop, &res);
+   return 1;
+}
+
+
+int
+mpc_fma_limbs (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_srcptr op3,
+   mpc_rnd_t rnd, int *inex)
+{
+   term_t t [3];
+   result_t re, im;
+   mpfr_exp_t emin, emax;
+   int n, inex_re, inex_im;
+
+   if (GMP_NAIL_BITS != 0
+       || !limbs_p (mpc_realref (rop)) || !limbs_p (mpc_imagref (rop))
+       || !limbs_p (mpc_realref (op1)) || !limbs_p (mpc_imagref (op1))
+       || !limbs_p (mpc_realref (op2)) || !limbs_p (mpc_imagref (op2))
+       || !limbs_p (mpc_realref (op3)) || !limbs_p (mpc_imagref (op3))
+       || !mpfr_regular_p (mpc_realref (op1))
+       || !mpfr_regular_p (mpc_imagref (op1))
+       || !mpfr_regular_p (mpc_realref (op2))
+       || !mpfr_regular_p (mpc_imagref (op2)))
+      return 0;
+
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   term_mul (t, mpc_realref (op1), mpc_realref (op2), 0);
+   term_mul (t + 1, mpc_imagref (op1), mpc_imagref (op2), 1);
+   n = 2;
+   if (!mpfr_zero_p (mpc_realref (op3)))
+      term_set (t + n++, mpc_realref (op3));
+   if (!round_sum (&re, t, n, MPC_PREC_RE (rop), MPC_RND_RE (rnd),
+                   emin, emax))
+      return 0;
+   term_mul (t, mpc_realref (op1), mpc_imagref (op2), 0);
+   term_mul (t + 1, mpc_imagref (op1), mpc_realref (op2), 0);
+   n = 2;
+   if (!mpfr_zero_p (mpc_imagref (op3)))
+      term_set (t + n++, mpc_imagref (op3));
+   if (!round_sum (&im, t, n, MPC_PREC_IM (rop), MPC_RND_IM (rnd),
+                   emin, emax))
+      return 0;
+
+   inex_re = result_set (mpc_realref (rop), &re);
+   inex_im = result_set (mpc_imagref (rop), &im);
+   *inex = MPC_INEX (inex_re, inex_im);
+   return 1;
+}
+
+
+int
+mpc_fmma_limbs (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_srcptr op3,
+   mpc_srcptr op4, int neg, mpc_rnd_t rnd, int *inex)
+{
+   term_t t [4];
+   result_t re, im;
+   mpfr_exp_t emin, emax;
+   int inex_re, inex_im;
+
+   if (GMP_NAIL_BITS != 0
+       || !limbs_p (mpc_realref (rop)) || !limbs_p (mpc_imagref (rop))
+       || !limbs_p (mpc_realref (op1)) || !limbs_p (mpc_imagref (op1))
+       || !limbs_p (mpc_realref (op2)) || !limbs_p (mpc_imagref (op2))
+       || !limbs_p (mpc_realref (op3)) || !limbs_p (mpc_imagref (op3))
+       || !limbs_p (mpc_realref (op4)) || !limbs_p (mpc_imagref (op4))
+       || !mpfr_regular_p (mpc_realref (op1))
+       || !mpfr_regular_p (mpc_imagref (op1))
+       || !mpfr_regular_p (mpc_realref (op2))
+       || !mpfr_regular_p (mpc_imagref (op2))
+       || !mpfr_regular_p (mpc_realref (op3))
+       || !mpfr_regular_p (mpc_imagref (op3))
+       || !mpfr_regular_p (mpc_realref (op4))
+       || !mpfr_regular_p (mpc_imagref (op4)))
+      return 0;
+
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   term_mul (t, mpc_realref (op1), mpc_realref (op2), 0);
+   term_mul (t + 1, mpc_imagref (op1), mpc_imagref (op2), 1);
+   term_mul (t + 2, mpc_realref (op3), mpc_realref (op4), neg);
+   term_mul (t + 3, mpc_imagref (op3), mpc_imagref (op4), !neg);
+   if (!round_sum (&re, t, 4, MPC_PREC_RE (rop), MPC_RND_RE (rnd),
+                   emin, emax))
+      return 0;
+   term_mul (t, mpc_realref (op1), mpc_imagref (op2), 0);
+   term_mul (t + 1, mpc_imagref (op1), mpc_realref (op2), 0);
+   term_mul (t + 2, mpc_realref (op3), mpc_imagref (op4), neg);
+   term_mul (t + 3, mpc_imagref (op3), mpc_realref (op4), neg);
+   if (!round_sum (&im, t, 4, MPC_PREC_IM (rop), MPC_RND_IM (rnd),
+                   emin, emax))
+      return 0;
+
+   inex_re = result_set (mpc_realref (rop), &re);
+   inex_im = result_set (mpc_imagref (rop), &im);
+   *inex = MPC_INEX (inex_re, inex_im);
+   return 1;
+}
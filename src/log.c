@@ -1,6 +1,6 @@
 /* mpc_log -- Take the logarithm of a complex number.
 
-Copyright (C) 2008, 2009, 2010, 2011, 2012, 2024 INRIA
+Copyright (C) 2008, 2009, 2010, 2011, 2012, 2024, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -88,7 +88,7 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
          w [0] = *mpc_realref (op);
          MPFR_CHANGE_SIGN (w);
          inex_re = mpfr_log (mpc_realref (rop), w, MPC_RND_RE (rnd));
-         inex_im = mpfr_const_pi (mpc_imagref (rop), rnd_im);
+         inex_im = mpc_const_pi (mpc_imagref (rop), rnd_im);
          if (negative_zero) {
             mpc_conj (rop, rop, MPC_RNDNN);
             inex_im = -inex_im;
@@ -99,7 +99,7 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
    else if (re_cmp == 0) {
       if (im_cmp > 0) {
          inex_re = mpfr_log (mpc_realref (rop), mpc_imagref (op), MPC_RND_RE (rnd));
-         inex_im = mpfr_const_pi (mpc_imagref (rop), MPC_RND_IM (rnd));
+         inex_im = mpc_const_pi (mpc_imagref (rop), MPC_RND_IM (rnd));
          /* division by 2 does not change the ternary flag */
          mpfr_div_2ui (mpc_imagref (rop), mpc_imagref (rop), 1, MPFR_RNDN);
       }
@@ -107,7 +107,7 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
          w [0] = *mpc_imagref (op);
          MPFR_CHANGE_SIGN (w);
          inex_re = mpfr_log (mpc_realref (rop), w, MPC_RND_RE (rnd));
-         inex_im = mpfr_const_pi (mpc_imagref (rop), INV_RND (MPC_RND_IM (rnd)));
+         inex_im = mpc_const_pi (mpc_imagref (rop), INV_RND (MPC_RND_IM (rnd)));
          /* division by 2 does not change the ternary flag */
          mpfr_div_2ui (mpc_imagref (rop), mpc_imagref (rop), 1, MPFR_RNDN);
          mpfr_neg (mpc_imagref (rop), mpc_imagref (rop), MPFR_RNDN);
@@ -116,8 +116,11 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
       return MPC_INEX(inex_re, inex_im);
    }
 
+   if (mpc_log_dd (rop, op, rnd, &inex_re))
+      return inex_re;
+
    prec = MPC_PREC_RE(rop);
-   mpfr_init2 (w, 2);
+   mpc_tmp_fr_init2 (w, 2);
    /* Let op = x + iy; log = 1/2 log (x^2 + y^2) + i atan2 (y, x)
       Loop for the real part: 1/2 log (x^2 + y^2).
       At precision p, this has a complexity of M(p)log(p) + O (M(p))
@@ -161,7 +164,7 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
 
    if (!ok) {
       prec = MPC_PREC_RE(rop);
-      mpfr_init2 (v, 2);
+      mpc_tmp_fr_init2 (v, 2);
       /* compute 1/2 log (x^2 + y^2) = log |x| + 1/2 * log (1 + (y/x)^2)
             if |x| >= |y|; otherwise, exchange x and y                   */
       if (mpfr_cmpabs (mpc_realref (op), mpc_imagref (op)) >= 0) {
@@ -214,7 +217,7 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
       } while (!underflow &&
                !mpfr_can_round (w, prec - err, MPFR_RNDN, MPFR_RNDZ,
                mpfr_get_prec (mpc_realref (rop)) + (MPC_RND_RE (rnd) == MPFR_RNDN)));
-      mpfr_clear (v);
+      mpc_tmp_fr_clear (v);
    }
 
    /* imaginary part */
@@ -228,6 +231,6 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
                                   mpfr_get_emin_min () - 2, MPC_RND_RE (rnd));
    else
       inex_re = mpfr_set (mpc_realref (rop), w, MPC_RND_RE (rnd));
-   mpfr_clear (w);
+   mpc_tmp_fr_clear (w);
    return MPC_INEX(inex_re, inex_im);
 }
@@ -0,0 +1,183 @@
+/* mpc_log1p -- logarithm of one plus a complex number.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+int
+mpc_log1p (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   mpfr_srcptr x = mpc_realref (op), y = mpc_imagref (op);
+   mpfr_t w, a, v, l, th;
+   mpc_t z;
+   mpfr_prec_t prec;
+   mpfr_exp_t err_re, err_im;
+   int loop = 0, exact_re, inex_w, underflow = 0, inex_a, inex_v, inex_re, inex_im;
+   mpfr_exp_t saved_emin, saved_emax;
+
+   /* special values: NaN and infinities are those of log(op), since
+      adding 1 does not change them and only the signs of a finite real
+      part matter for the arc tangent */
+   if (!mpc_fin_p (op))
+      return mpc_log (rop, op, rnd);
+
+   if (mpfr_zero_p (y) && mpfr_cmp_si (x, -1) >= 0) {
+      /* log1p(x+i*0) = log1p(x) +i*0 for x >= -1, where log1p(-1) = -inf
+         raises the division-by-zero flag */
+      inex_re = mpfr_log1p (mpc_realref (rop), x, MPC_RND_RE (rnd));
+      inex_im = mpfr_set (mpc_imagref (rop), y, MPC_RND_IM (rnd));
+      return MPC_INEX (inex_re, inex_im);
+   }
+
+   saved_emin = mpfr_get_emin ();
+   saved_emax = mpfr_get_emax ();
+   mpfr_set_emin (mpfr_get_emin_min ());
+   mpfr_set_emax (mpfr_get_emax_max ());
+
+   /* Let w = 1 + x, so that log1p(op) = log |w + i*y| + i * atan2 (y, w).
+      The real part is computed as 1/2 log1p (v) with v = x (2+x) + y^2 when
+      1/2 < 1 + v = |w + i*y|^2 <= 2, which avoids cancellation for op close
+      to 0, and as 1/2 log (w^2 + y^2) otherwise. If v is exact, which is
+      the case for x = 0 since v has at least 2 prec (y) bits, the real part
+      is rounded directly by mpfr_log1p after the loop; this also covers
+      tiny v, where it is close to v/2. */
+   prec = MPC_MAX_PREC (rop);
+   prec += mpc_ceil_log2 (prec) + 6;
+   mpc_tmp_fr_init2 (w, prec);
+   mpc_tmp_fr_init2 (a, prec);
+   mpc_tmp_fr_init2 (v, MPC_MAX (prec, 2 * mpfr_get_prec (y)));
+   mpc_tmp_fr_init2 (l, prec);
+   mpc_tmp_fr_init2 (th, prec);
+
+   for (;;) {
+      /* o(1 + x) has a relative error of at most 2^(-prec); since the
+         derivative of atan2 (y, w) with respect to w is
+         -sin (th) cos (th) / w, the error on th = o(atan2 (y, o(1+x))) is
+         at most |th| 2^(-prec) (1 + 2^(-prec)) + 1/2 ulp (th)
+         <= 2^(Exp (th) + 1 - prec). If 1 + x is exact, the imaginary part
+         is rounded directly by mpfr_atan2 after the loop, which also
+         covers the case of tiny y, where th is close to y/w. */
+      inex_w = mpfr_add_ui (w, x, 1, MPFR_RNDN);
+      if (inex_w != 0)
+         mpfr_atan2 (th, y, w, MPFR_RNDN);
+      err_im = 1;
+
+      /* v = o(x o(2+x) + y^2) has an error of at most
+         |x (2+x)| 2^(-prec) (1 + 2^(-prec)) + 1/2 ulp (v). */
+      inex_a = mpfr_add_ui (a, x, 2, MPFR_RNDN);
+      inex_v = mpfr_fmma (v, x, a, y, y, MPFR_RNDN);
+      exact_re = (inex_a == 0 && inex_v == 0);
+      if (exact_re)
+         err_re = 0;
+      else if (mpfr_zero_p (v)) {
+         /* v underflows even in the extended exponent range, and so does
+            the real part, which is about v/2 */
+         underflow = (mpfr_signbit (v) ? -1 : +1);
+         mpfr_set_zero (l, underflow);
+         err_re = 0;
+      }
+      else if (mpfr_cmp_si_2exp (v, -1, -1) > 0 && mpfr_cmp_ui (v, 1) <= 0) {
+         /* 1/(1+v) < 2, so the error on o(log1p (v)) is at most
+            2^(Exp (x) + Exp (2+x) + 1 - prec) + 2^(Exp (v) - prec)
+            + 2^(Exp (l) - 1 - prec), up to a factor 1 + 2^(-prec) */
+         mpfr_log1p (l, v, MPFR_RNDN);
+         err_re = mpfr_get_exp (v);
+         if (!mpfr_zero_p (x))
+            err_re = MPC_MAX (err_re,
+                              mpfr_get_exp (x) + mpfr_get_exp (a) + 1);
+         err_re = MPC_MAX (err_re, mpfr_get_exp (l) - 1) + 2
+                  - mpfr_get_exp (l);
+      }
+      else {
+         /* The relative error on o(w^2 + y^2) is at most
+            3.01 * 2^(-prec), so o(log (...)) has an error of at most
+            3.05 * 2^(-prec) + 1/2 ulp <= 2^(max (2, Exp - 1) + 1 - prec);
+            as |log (...)| >= log (2), we have Exp >= 0. */
+         mpfr_fmma (l, w, w, y, y, MPFR_RNDN);
+         if (mpfr_inf_p (l) || mpfr_zero_p (l)) {
+            /* overflow or underflow in the extended exponent range;
+               the real part of the logarithm of w + i*y, whose relative
+               error is at most 2^(-prec), has an error of at most
+               2^(-prec) (1 + 2^(-prec)) + 1/2 ulp */
+            mpc_init3 (z, prec, mpfr_get_prec (y));
+            mpfr_set (mpc_realref (z), w, MPFR_RNDN);
+            mpfr_set (mpc_imagref (z), y, MPFR_RNDN);
+            mpc_log (z, z, MPC_RNDNN);
+            mpfr_mul_2ui (l, mpc_realref (z), 1, MPFR_RNDN);
+            mpc_clear (z);
+         }
+         else
+            mpfr_log (l, l, MPFR_RNDN);
+         err_re = MPC_MAX (2, mpfr_get_exp (l) - 1) + 1 - mpfr_get_exp (l);
+      }
+      if (!exact_re)
+         mpfr_div_2ui (l, l, 1, MPFR_RNDN);
+
+      if ((exact_re || underflow
+           || mpfr_can_round (l, prec - err_re, MPFR_RNDN, MPFR_RNDZ,
+                 MPC_PREC_RE (rop) + (MPC_RND_RE (rnd) == MPFR_RNDN)))
+          && (inex_w == 0
+              || mpfr_can_round (th, prec - err_im, MPFR_RNDN, MPFR_RNDZ,
+                    MPC_PREC_IM (rop) + (MPC_RND_IM (rnd) == MPFR_RNDN))))
+         break;
+
+      /* the first time, add the number of lost bits */
+      if (++loop == 1)
+         prec += MPC_MAX (err_re, err_im);
+      else
+         prec += prec / 2;
+      mpfr_set_prec (w, prec);
+      mpfr_set_prec (a, prec);
+      mpfr_set_prec (v, MPC_MAX (prec, 2 * mpfr_get_prec (y)));
+      mpfr_set_prec (l, prec);
+      mpfr_set_prec (th, prec);
+   }
+
+   if (inex_w == 0)
+      inex_im = mpfr_atan2 (mpc_imagref (rop), y, w, MPC_RND_IM (rnd));
+   else
+      inex_im = mpfr_set (mpc_imagref (rop), th, MPC_RND_IM (rnd));
+   if (exact_re) {
+      /* 1 + v > 0 since y != 0 */
+      inex_re = mpfr_log1p (mpc_realref (rop), v, MPC_RND_RE (rnd));
+      mpfr_div_2ui (mpc_realref (rop), mpc_realref (rop), 1, MPFR_RNDN);
+   }
+   else
+      inex_re = mpfr_set (mpc_realref (rop), l, MPC_RND_RE (rnd));
+
+   mpc_tmp_fr_clear (th);
+   mpc_tmp_fr_clear (l);
+   mpc_tmp_fr_clear (v);
+   mpc_tmp_fr_clear (a);
+   mpc_tmp_fr_clear (w);
+
+   /* restore the exponent range, and check the range of results */
+   mpfr_set_emin (saved_emin);
+   mpfr_set_emax (saved_emax);
+   if (underflow)
+      /* create underflow in result, as in mpc_log */
+      inex_re = mpfr_set_si_2exp (mpc_realref (rop), underflow,
+                                  mpfr_get_emin_min () - 2, MPC_RND_RE (rnd));
+   else
+      inex_re = mpfr_check_range (mpc_realref (rop), inex_re,
+                                  MPC_RND_RE (rnd));
+   inex_im = mpfr_check_range (mpc_imagref (rop), inex_im, MPC_RND_IM (rnd));
+
+   return MPC_INEX (inex_re, inex_im);
+}
@@ -15,14 +15,12 @@ FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
 more details.
 
 You should have received a copy of the GNU Lesser General Public License
-along with this program. If not, see http://logw.gnu.org/licenses/ .
+along with this program. If not, see http://www.gnu.org/licenses/ .
 */
 
 #include <limits.h> /* for CHAR_BIT */
 #include "mpc-impl.h"
 
-/* this file was copied from log10.c */
-
 /* return non-zero if |x|=2^k */
 static int
 is_power_of_two (mpfr_srcptr x)
@@ -30,128 +28,286 @@ is_power_of_two (mpfr_srcptr x)
   return mpfr_min_prec (x) == 1;
 }
 
-int
-mpc_log2 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+static int
+log_base_real (mpfr_ptr rop, mpfr_srcptr op, int base, mpfr_rnd_t rnd)
 {
-   int ok = 0, loop = 0, special_re, special_im,
-       inex, inex_re, inex_im;
-   mpfr_prec_t prec;
-   mpfr_t log2;
-   mpc_t log;
-   mpfr_exp_t saved_emin, saved_emax;
+   return (base == 2 ? mpfr_log2 (rop, op, rnd) : mpfr_log10 (rop, op, rnd));
+}
 
-   saved_emin = mpfr_get_emin ();
-   saved_emax = mpfr_get_emax ();
-   mpfr_set_emin (mpfr_get_emin_min ());
-   mpfr_set_emax (mpfr_get_emax_max ());
+static int
+log_abs_exact (mpfr_ptr rop, mpfr_srcptr x, mpfr_srcptr y, int base,
+               mpfr_rnd_t rnd, int *inex)
+   /* Assuming x and y are regular numbers, detect whether
+      log (x^2+y^2) / (2 log (base)) is exact; if so, set rop to it,
+      *inex to the ternary value and return non-zero.
+      For base 2, x^2+y^2 = 2^s with x = u/2^e and y = v/2^e, u and v odd
+      or zero integers, implies u^2+v^2 = 2^(s+2e); since the square of an
+      odd integer is 1 mod 8, the only solution with u and v both non-zero
+      is |u| = |v| = 1, that is, |x| = |y| = 2^k.
+      For base 10, x^2+y^2 cannot equal 10^(a/2^b) for a, b integers, a odd,
+      b>0, since x^2+y^2 is rational, and 10^(a/2^b) is irrational.
+      Similarly, for b=0, x^2+y^2 cannot equal 10^a for a < 0 since x^2+y^2
+      is a rational with denominator a power of 2.
+      Now let x^2+y^2 = 10^s. Without loss of generality we can assume
+      x = u/2^e and y = v/2^e with u, v, e integers: u^2+v^2 = 10^s*2^(2e)
+      thus u^2+v^2 = 0 mod 2^(2e). By recurrence on e, necessarily
+      u = v = 0 mod 2^e, thus x and y are necessarily integers. */
+{
+   int ok = 0;
 
-   mpfr_init2 (log2, 2);
-   mpc_init2 (log, 2);
-   prec = MPC_MAX_PREC (rop);
-   /* compute log(op)/log(2) */
-   while (ok == 0) {
-      MPC_LOOP_NEXT(loop, op, rop);
-      prec += (loop <= 2) ? mpc_ceil_log2 (prec) + 4 : prec / 2;
-      mpfr_set_prec (log2, prec);
-      mpc_set_prec (log, prec);
-
-      inex = mpc_log (log, op, MPFR_RNDN);
-      /* error <= k1 = 1/2 ulp for the real and the imaginary part */
-
-      if (!mpfr_number_p (mpc_imagref (log)) || mpfr_zero_p (mpc_imagref (log))) {
-         /* no need to divide by log(2) */
-         special_im = 1;
+   if (base == 2) {
+      if (mpfr_cmpabs (x, y) == 0 && is_power_of_two (x)) {
+         /* |x| = |y| = 2^(ex-1) thus log2(x^2+y^2)/2 = (2 ex - 1) / 2 */
+         *inex = mpfr_set_si_2exp (rop, 2 * mpfr_get_exp (x) - 1, -1, rnd);
          ok = 1;
       }
-      else {
-         special_im = 0;
-         mpfr_const_log2 (log2, MPFR_RNDN);
-         /* error <= k2 = 1/2 ulp */
-         mpfr_div (mpc_imagref (log), mpc_imagref (log), log2, MPFR_RNDN);
-         /* by the generic error of division
-            (eq:proprealdiv in algorithms.tex), +1/2 ulp for final rounding:
-            error <= (2 (k1+k2) / (1 - k2 2^(1-prec))) + 1/2 ulp
-                  <= 4 ulp for prec >= 2 */
-         ok = mpfr_can_round (mpc_imagref (log), prec - 2,
-                  MPFR_RNDN, MPFR_RNDZ,
-                  MPC_PREC_IM(rop) + (MPC_RND_IM (rnd) == MPFR_RNDN));
+   }
+   else if (mpfr_integer_p (x) && mpfr_integer_p (y)) {
+      mpz_t u, v;
+      unsigned long s, k;
+
+      mpz_init (u);
+      mpz_init (v);
+      mpfr_get_z (u, x, MPFR_RNDN); /* exact */
+      mpfr_get_z (v, y, MPFR_RNDN); /* exact */
+      mpz_mul (u, u, u);
+      mpz_mul (v, v, v);
+      mpz_add (u, u, v); /* x^2+y^2 */
+      k = mpz_scan1 (u, 0);
+      /* if u = 10^s then necessarily s = k */
+      s = mpz_sizeinbase (u, 10);
+      /* since s is either the number of digits of u or one more,
+         then u = 10^(s-1) or 10^(s-2) */
+      if (s == k + 1 || s == k + 2) {
+         mpz_div_2exp (u, u, k);
+         mpz_ui_pow_ui (v, 5, k);
+         if (mpz_cmp (u, v) == 0) {
+            /* log10(x^2+y^2)/2 is exactly k/2 */
+            *inex = mpfr_set_ui_2exp (rop, k, -1, rnd);
+            ok = 1;
+         }
       }
+      mpz_clear (u);
+      mpz_clear (v);
+   }
 
-      if (ok) {
-         if (!mpfr_number_p (mpc_realref (log)) || mpfr_zero_p (mpc_realref (log)))
-            special_re = 1;
+   return ok;
+}
+
+static int
+log_abs_base (mpfr_ptr rop, mpc_srcptr op, int base, mpfr_rnd_t rnd)
+   /* Set rop to log |op| / log (base) for op with regular real and
+      imaginary parts, rounded according to rnd, and return the ternary
+      value; rop may be the real or the imaginary part of op. */
+{
+   mpfr_t x, y, w, v, l;
+   mpfr_prec_t prec;
+   mpfr_exp_t err, expa;
+   int loop = 0, check_exact = 0, inex;
+   mpc_t z;
+
+   /* Let |x| >= |y|. */
+   if (mpfr_cmpabs (mpc_realref (op), mpc_imagref (op)) >= 0) {
+      x [0] = mpc_realref (op) [0];
+      y [0] = mpc_imagref (op) [0];
+   }
+   else {
+      x [0] = mpc_imagref (op) [0];
+      y [0] = mpc_realref (op) [0];
+   }
+   if (mpfr_signbit (x))
+      MPFR_CHANGE_SIGN (x);
+   if (mpfr_signbit (y))
+      MPFR_CHANGE_SIGN (y);
+   z->re [0] = x [0];
+   z->im [0] = y [0];
+
+   prec = mpfr_get_prec (rop);
+   mpc_tmp_fr_init2 (l, 2);
+   mpc_tmp_fr_init2 (w, 2);
+   mpc_tmp_fr_init2 (v, 2);
+   for (;;) {
+      MPC_LOOP_NEXT (loop, op, op);
+      prec += (loop <= 2) ? mpc_ceil_log2 (prec) + 6 : prec / 2;
+      mpfr_set_prec (l, prec);
+      mpfr_set_prec (w, prec);
+      mpfr_set_prec (v, prec);
+
+      err = -1;
+      if (loop <= 2 && mpfr_cmp_ui (x, 1) != 0) {
+         /* w = o(x^2+y^2) has a relative error of at most 2^(-prec),
+            so o(log (w)) has an error of at most
+            2^(-prec) (1 + 2^(-prec)) + 1/2 ulp, and after halving at most
+            2^(max (-Exp (w), 0) + 1) ulp (w) */
+         mpc_norm (w, z, MPFR_RNDN);
+         if (!mpfr_inf_p (w) && !mpfr_zero_p (w)) {
+            mpfr_log (w, w, MPFR_RNDN);
+            mpfr_div_2ui (w, w, 1, MPFR_RNDN);
+            if (!mpfr_zero_p (w))
+               err = MPC_MAX (-mpfr_get_exp (w), 0) + 1;
+         }
+      }
+      if (err < 0) {
+         /* w = log (x) + 1/2 log1p ((y/x)^2), which is exact for x = 1 and
+            avoids an overflow in x^2+y^2. The relative error on
+            o(o(y/x)^2) is at most 3.01 * 2^(-prec); log1p having a
+            condition number of at most 1 for a non-negative argument,
+            the relative error on h = o(log1p (...)) / 2 is at most
+            4.1 * 2^(-prec), so that its error is below 2^(Exp (h) + 3 - prec).
+            With a = o(log (x)), the error on w = o(a + h) is at most
+            2^(Exp (a) - 1 - prec) + 2^(Exp (h) + 3 - prec)
+            + 2^(Exp (w) - 1 - prec), whence err below. */
+         mpfr_div (v, y, x, MPFR_RNDN);
+         mpfr_sqr (v, v, MPFR_RNDN);
+         mpfr_log1p (v, v, MPFR_RNDN);
+         mpfr_div_2ui (v, v, 1, MPFR_RNDN);
+         mpfr_log (w, x, MPFR_RNDN);
+         if (mpfr_zero_p (v)) {
+            /* (y/x)^2 underflows even in the extended exponent range */
+            if (mpfr_zero_p (w)) {
+               /* x = 1, and log |op| underflows as well */
+               inex = mpfr_set_ui_2exp (rop, 1, mpfr_get_emin_min () - 2,
+                                        rnd);
+               break;
+            }
+            /* otherwise the neglected term is far below 1/2 ulp (w) */
+            err = 1;
+         }
          else {
-            special_re = 0;
-            if (special_im)
-               /* log2 not yet computed */
-              mpfr_const_log2 (log2, MPFR_RNDN);
-            mpfr_div (mpc_realref (log), mpc_realref (log), log2, MPFR_RNDN);
-            /* same error analysis as above */
-            ok = mpfr_can_round (mpc_realref (log), prec - 2,
-                     MPFR_RNDN, MPFR_RNDZ,
-                     MPC_PREC_RE(rop) + (MPC_RND_RE (rnd) == MPFR_RNDN));
+            expa = (mpfr_zero_p (w) ? mpfr_get_exp (v) : mpfr_get_exp (w));
+            mpfr_add (w, w, v, MPFR_RNDN);
+            if (!mpfr_zero_p (w))
+               err = MPC_MAX (MPC_MAX (expa - 1, mpfr_get_exp (v) + 3),
+                              mpfr_get_exp (w) - 1) + 2 - mpfr_get_exp (w);
          }
-         
-         /* Special code to deal with cases where the real part of log2(x+i*y)
-            is exact, like x=y=1. Since Re(log2(x+i*y)) = log2(x^2+y^2)/2
-            this happens whenever x^2+y^2 is a power of 2.
-            Without loss of generality we can assume x = u/2^e and y = v/2^e
-            with u, v, e integers. We obtain u^2+v^2 = 2^s for s integer.
-            The only solutions are (up to sign):
-            (a) u=v=s^((s-1)/2) for s odd >= 1
-            (b) u=0 and v=2^(s/2) or u=2^(s/2) and v=0 for s even >= 0.
-            Indeed, for s < 0 there is no solution.
-            For s=0 the only solutions are (u,v)=(0,1) and (1,0).
-            For s=1 the only solution is (u,v)=(1,1).
-            For s>=2, since 2^s = 0 mod 4, the sum u^2+v^2 must be divisible by 4;
-            the only solution is when both u and v are even, since u^2+v^2 = 1 mod 4
-            if exactly one is odd, and u^2+v^2 = 2 mod 4 if both are odd.
-            Thus by induction u'=u/2 and v'=v/2 are solutions of u'^2+v'^2 = 2^(s-2).
-         */
-         if (!ok) {
-           if (mpfr_zero_p (mpc_realref (op)) && is_power_of_two (mpc_imagref (op))) {
-             /* x=0 and y=2^k */
-             mpfr_exp_t ey = mpfr_get_exp (mpc_imagref (op));
-             /* |y| = 2^(ey-1) thus log2(x^2+y^2)/2 = ey-1 */
-             ok = mpfr_set_si (mpc_realref (log), ey - 1, MPFR_RNDN) == 0;
-             /* if the conversion is not exact, because the working precision is
-                too small, it will be exact for a larger working precision */
-           }
-           else if (mpfr_zero_p (mpc_imagref (op)) && is_power_of_two (mpc_realref (op))) {
-             /* x=2^k and y=0 */
-             mpfr_exp_t ex = mpfr_get_exp (mpc_realref (op));
-             /* |x| = 2^(ex-1) thus log2(x^2+y^2)/2 = ex-1 */
-             ok = mpfr_set_si (mpc_realref (log), ex - 1, MPFR_RNDN) == 0;
-             /* if the conversion is not exact, because the working precision is
-                too small, it will be exact for a larger working precision */
-           }
-           else if (mpfr_cmpabs (mpc_realref (op), mpc_imagref (op)) == 0
-                    && is_power_of_two (mpc_realref (op))) {
-             mpfr_exp_t ex = mpfr_get_exp (mpc_realref (op));
-             /* |x| = |y| = 2^(ex-1) thus log2(x^2+y^2)/2 = (2 ex - 1) / 2 */
-             ok = (mpfr_set_si (mpc_realref (log), ex, MPFR_RNDN) == 0)
-                  && (mpfr_mul_2ui (mpc_realref (log), mpc_realref (log), 1,
-                                      MPFR_RNDN) == 0)
-                  && (mpfr_sub_ui (mpc_realref (log), mpc_realref (log), 1,
-                                     MPFR_RNDN) == 0)
-                  && (mpfr_div_2ui (mpc_realref (log), mpc_realref (log), 1,
-                                    MPFR_RNDN) == 0);
-             /* if one operation is not exact, because the working precision is
-                too small, it will be exact for a larger working precision */
-           }
+      }
+
+      if (err >= 0) {
+         /* The relative errors on w and on l = log (base) are at most
+            2^(err + 1 - prec) and 2^(1 - prec), so that on w / l is at
+            most (2^(err + 1) + 2 + 1) * 2^(-prec) (1 + 2^(2 - prec))
+            <= 2^(err + 2 - prec) for err >= 1, which is an error of at
+            most 2^(err + 2) ulp. */
+         mpc_const_log_base (l, base);
+         mpfr_div (w, w, l, MPFR_RNDN);
+         if (mpfr_can_round (w, prec - err - 2, MPFR_RNDN, MPFR_RNDZ,
+                             mpfr_get_prec (rop) + (rnd == MPFR_RNDN))) {
+            inex = mpfr_set (rop, w, rnd);
+            break;
          }
       }
+
+      if (!check_exact) {
+         check_exact = 1;
+         if (log_abs_exact (rop, x, y, base, rnd, &inex))
+            break;
+      }
    }
+   mpc_tmp_fr_clear (v);
+   mpc_tmp_fr_clear (w);
+   mpc_tmp_fr_clear (l);
 
-   inex_re = mpfr_set (mpc_realref(rop), mpc_realref (log), MPC_RND_RE (rnd));
-   if (special_re)
-      inex_re = MPC_INEX_RE (inex);
-      /* recover flag from call to mpc_log above */
-   inex_im = mpfr_set (mpc_imagref(rop), mpc_imagref (log), MPC_RND_IM (rnd));
-   if (special_im)
-      inex_im = MPC_INEX_IM (inex);
-   mpfr_clear (log2);
-   mpc_clear (log);
+   return inex;
+}
+
+static int
+arg_base (mpfr_ptr rop, mpc_srcptr op, int base, mpfr_rnd_t rnd)
+   /* Set rop to arg (op) / log (base) for op without NaN, rounded
+      according to rnd, and return the ternary value. */
+{
+   mpfr_srcptr x = mpc_realref (op), y = mpc_imagref (op);
+   mpfr_t a, l;
+   mpfr_prec_t prec;
+   int loop = 0, inex;
+
+   if ((mpfr_zero_p (y) || (mpfr_inf_p (x) && mpfr_number_p (y)))
+       && !mpfr_signbit (x)) {
+      /* atan2 (y, x) is a zero with the sign of y */
+      mpfr_set_zero (rop, mpfr_signbit (y) ? -1 : +1);
+      return 0;
+   }
+
+   prec = mpfr_get_prec (rop);
+   mpc_tmp_fr_init2 (l, 2);
+   mpc_tmp_fr_init2 (a, 2);
+   do {
+      MPC_LOOP_NEXT (loop, op, op);
+      prec += (loop <= 2) ? mpc_ceil_log2 (prec) + 5 : prec / 2;
+      mpfr_set_prec (l, prec);
+      mpfr_set_prec (a, prec);
+      mpfr_atan2 (a, y, x, MPFR_RNDN);
+      mpc_const_log_base (l, base);
+      mpfr_div (a, a, l, MPFR_RNDN);
+      /* the relative errors on the arc tangent and on l are at most
+         2^(-prec) and 2^(1-prec), so that on the quotient is at most
+         4.01 * 2^(-prec), and its error at most 2^3 ulp */
+   } while (!mpfr_can_round (a, prec - 3, MPFR_RNDN, MPFR_RNDZ,
+                             mpfr_get_prec (rop) + (rnd == MPFR_RNDN)));
+   inex = mpfr_set (rop, a, rnd);
+   mpc_tmp_fr_clear (a);
+   mpc_tmp_fr_clear (l);
+
+   return inex;
+}
+
+/* Set rop to log (op) / log (base) for base 2 or 10. The special values
+   are those of mpc_log, and both parts are computed independently, so
+   that the imaginary part is not recomputed when the real part needs a
+   higher working precision, nor conversely. */
+int
+mpc_log_base (mpc_ptr rop, mpc_srcptr op, int base, mpc_rnd_t rnd)
+{
+   mpfr_t im, t;
+   int inex_re, inex_im;
+   mpfr_exp_t saved_emin, saved_emax;
+
+   /* special values, as in mpc_log */
+   if (mpfr_nan_p (mpc_realref (op)) || mpfr_nan_p (mpc_imagref (op))) {
+      if (mpfr_inf_p (mpc_realref (op)) || mpfr_inf_p (mpc_imagref (op)))
+         mpfr_set_inf (mpc_realref (rop), +1);
+      else
+         mpfr_set_nan (mpc_realref (rop));
+      mpfr_set_nan (mpc_imagref (rop));
+      return MPC_INEX (0, 0);
+   }
+
+   if (mpfr_regular_p (mpc_realref (op)) && mpfr_regular_p (mpc_imagref (op))
+       && mpc_log_base_dd (rop, op, base, rnd, &inex_re))
+      return inex_re;
+
+   saved_emin = mpfr_get_emin ();
+   saved_emax = mpfr_get_emax ();
+   mpfr_set_emin (mpfr_get_emin_min ());
+   mpfr_set_emax (mpfr_get_emax_max ());
+
+   /* The imaginary part is computed first in a temporary variable, since
+      rop may be op. */
+   mpc_tmp_fr_init2 (im, MPC_PREC_IM (rop));
+   inex_im = arg_base (im, op, base, MPC_RND_IM (rnd));
+
+   if (mpfr_inf_p (mpc_realref (op)) || mpfr_inf_p (mpc_imagref (op))) {
+      mpfr_set_inf (mpc_realref (rop), +1);
+      inex_re = 0;
+   }
+   else if (mpfr_zero_p (mpc_realref (op)) && mpfr_zero_p (mpc_imagref (op))) {
+      mpfr_set_inf (mpc_realref (rop), -1);
+      mpfr_set_divby0 (); /* per the ISO C99 (G.6.3.2, The clog functions) */
+      inex_re = 0;
+   }
+   else if (mpfr_zero_p (mpc_realref (op)) || mpfr_zero_p (mpc_imagref (op))) {
+      /* |op| is the absolute value of the non-zero part; the real
+         functions detect the exact cases */
+      t [0] = (mpfr_zero_p (mpc_realref (op)) ? mpc_imagref (op)
+                                                : mpc_realref (op)) [0];
+      if (mpfr_signbit (t))
+         MPFR_CHANGE_SIGN (t);
+      inex_re = log_base_real (mpc_realref (rop), t, base, MPC_RND_RE (rnd));
+   }
+   else
+      inex_re = log_abs_base (mpc_realref (rop), op, base, MPC_RND_RE (rnd));
+
+   mpfr_set (mpc_imagref (rop), im, MPFR_RNDN); /* exact */
+   mpc_tmp_fr_clear (im);
 
    /* restore the exponent range, and check the range of results */
    mpfr_set_emin (saved_emin);
@@ -161,3 +317,9 @@ mpc_log2 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
 
    return MPC_INEX(inex_re, inex_im);
 }
+
+int
+mpc_log2 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   return mpc_log_base (rop, op, 2, rnd);
+}
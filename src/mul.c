@@ -1,6 +1,6 @@
 /* mpc_mul -- Multiply two complex numbers
 
-Copyright (C) 2002, 2004, 2005, 2008, 2009, 2010, 2011, 2012, 2016, 2020, 2022 INRIA
+Copyright (C) 2002, 2004, 2005, 2008, 2009, 2010, 2011, 2012, 2016, 2020, 2022, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -455,6 +455,139 @@ clear:
 }
 
 
+int
+mpc_mul_karatsuba3 (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2,
+                    mpc_rnd_t rnd)
+{
+   /* computes rop=op1*op2 by Karatsuba's algorithm with three
+      multiplications at a working precision close to the target precision,
+      where op1 and op2 are assumed to be finite and without zero parts;
+      see algorithms.tex for the error analysis.                          */
+   mpfr_srcptr a, b, c, d;
+   mpfr_t s, t, p1, p2, p3;
+   mpfr_prec_t prec, prec_in, lost;
+   mpfr_exp_t ea, eb, ec, ed, emax, err_re, err_im;
+   int inex_p1, inex_p2, inex_p3, inex_r, inex_i;
+   int ok_re = 0, ok_im = 0, inex_re = 0, inex_im = 0;
+   int loop;
+   const int MAX_MUL_LOOP = 2;
+
+   a = mpc_realref (op1);
+   b = mpc_imagref (op1);
+   c = mpc_realref (op2);
+   d = mpc_imagref (op2);
+   ea = mpfr_get_exp (a);
+   eb = mpfr_get_exp (b);
+   ec = mpfr_get_exp (c);
+   ed = mpfr_get_exp (d);
+   prec_in = MPC_MAX (MPC_MAX_PREC (op1), MPC_MAX_PREC (op2));
+   prec = MPC_MAX_PREC (rop);
+
+   /* Intermediate products are bounded above by 2^(emax), and non-zero
+      intermediate sums and differences below by 2^(emin) in absolute value.
+      Use the schoolbook method if one of them could leave the current
+      exponent range; the working precision is at most 3*prec + 16.      */
+   emax = MPC_MAX (ea, eb) + MPC_MAX (ec, ed) + 2;
+   if (emax >= mpfr_get_emax ()
+       || MPC_MIN (ea, eb) + MPC_MIN (ec, ed) - 2 * prec_in - 3 * prec - 20
+          <= mpfr_get_emin ())
+      return mpc_mul_naive (rop, op1, op2, rnd);
+
+   mpfr_init2 (s, 2);
+   mpfr_init2 (t, 2);
+   mpfr_init2 (p1, 2);
+   mpfr_init2 (p2, 2);
+   mpfr_init2 (p3, 2);
+
+   /* (a + i*b) * (c + i*d) = [ac - bd] + i*[(a+b)(c+d) - ac - bd] */
+   lost = 0;
+   for (loop = 0; loop < MAX_MUL_LOOP; loop++) {
+      if (lost > MPC_MAX_PREC (rop))
+         /* the schoolbook method is cheaper */
+         break;
+      prec += mpc_ceil_log2 (prec) + 5 + lost;
+
+      mpfr_set_prec (s, prec);
+      mpfr_set_prec (t, prec);
+      mpfr_set_prec (p1, prec);
+      mpfr_set_prec (p2, prec);
+      mpfr_set_prec (p3, prec);
+
+      inex_p1 = mpfr_mul (p1, a, c, MPFR_RNDN);
+      inex_p2 = mpfr_mul (p2, b, d, MPFR_RNDN);
+      inex_p3 = mpfr_add (s, a, b, MPFR_RNDN);
+      inex_p3 |= mpfr_add (t, c, d, MPFR_RNDN);
+      inex_p3 |= mpfr_mul (p3, s, t, MPFR_RNDN);
+      emax = MPC_MAX (mpfr_get_exp (p1), mpfr_get_exp (p2));
+      if (!mpfr_zero_p (p3))
+         emax = MPC_MAX (emax, mpfr_get_exp (p3));
+
+      /* real part in s, with an error of at most
+         2^(emax-prec) + 1/2 ulp(s) */
+      inex_r = mpfr_sub (s, p1, p2, MPFR_RNDN);
+      /* imaginary part in t, with an error of less than
+         5 * 2^(emax-prec) + 1/2 ulp(t) */
+      inex_i = mpfr_sub (t, p3, p1, MPFR_RNDN);
+      inex_i |= mpfr_sub (t, t, p2, MPFR_RNDN);
+
+      /* An exact zero part cannot be rounded by mpfr_can_round; in this
+         rare case, leave the sign of zero to the schoolbook method. */
+      if (   (inex_p1 == 0 && inex_p2 == 0 && inex_r == 0 && mpfr_zero_p (s))
+          || (inex_p1 == 0 && inex_p2 == 0 && inex_p3 == 0 && inex_i == 0
+              && mpfr_zero_p (t)))
+         break;
+
+      if (inex_p1 == 0 && inex_p2 == 0 && inex_r == 0)
+         /* s is the exact real part */
+         ok_re = 1;
+      else if (mpfr_zero_p (s))
+         ok_re = 0;
+      else {
+         err_re = MPC_MAX (emax - mpfr_get_exp (s), 0) + 1;
+         ok_re = mpfr_can_round (s, prec - err_re, MPFR_RNDN, MPFR_RNDZ,
+                    MPC_PREC_RE (rop) + (MPC_RND_RE (rnd) == MPFR_RNDN));
+      }
+      if (inex_p1 == 0 && inex_p2 == 0 && inex_p3 == 0 && inex_i == 0)
+         /* t is the exact imaginary part */
+         ok_im = 1;
+      else if (mpfr_zero_p (t))
+         ok_im = 0;
+      else {
+         err_im = MPC_MAX (emax - mpfr_get_exp (t), 0) + 3;
+         ok_im = mpfr_can_round (t, prec - err_im, MPFR_RNDN, MPFR_RNDZ,
+                    MPC_PREC_IM (rop) + (MPC_RND_IM (rnd) == MPFR_RNDN));
+      }
+
+      if (ok_re && ok_im) {
+         /* op1 and op2 are not needed any more, so rop may overlap them */
+         inex_re = mpfr_set (mpc_realref (rop), s, MPC_RND_RE (rnd));
+         inex_im = mpfr_set (mpc_imagref (rop), t, MPC_RND_IM (rnd));
+         break;
+      }
+
+      /* Increase the precision by the number of bits lost to cancellation,
+         which is zero if the failure is due to a hard-to-round case or
+         to a real or imaginary part of 0. */
+      lost = 0;
+      if (!ok_re && !mpfr_zero_p (s))
+         lost = MPC_MAX (emax - mpfr_get_exp (s), 0);
+      if (!ok_im && !mpfr_zero_p (t))
+         lost = MPC_MAX (lost, emax - mpfr_get_exp (t));
+   }
+
+   mpfr_clear (s);
+   mpfr_clear (t);
+   mpfr_clear (p1);
+   mpfr_clear (p2);
+   mpfr_clear (p3);
+
+   if (ok_re && ok_im)
+      return MPC_INEX (inex_re, inex_im);
+   else
+      return mpc_mul_naive (rop, op1, op2, rnd);
+}
+
+
 int
 mpc_mul (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
 {
@@ -462,6 +595,8 @@ mpc_mul (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
       infinities are treated specially if both parts are NaN when computed
       naively. See also
       https://www.open-std.org/jtc1/sc22/wg14/www/docs/n1399.htm */
+   int inex;
+
    if (mpc_inf_p (b))
       return mul_infinite (a, b, c);
    if (mpc_inf_p (c))
@@ -487,6 +622,9 @@ mpc_mul (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
    if (mpfr_zero_p (mpc_realref (c)))
       return mul_imag (a, b, c, rnd);
 
+   if (mpc_mul_limbs (a, b, c, rnd, &inex))
+      return inex;
+
    /* If the real and imaginary part of one argument have a very different */
    /* exponent, it is not reasonable to use Karatsuba multiplication.      */
    if (   SAFE_ABS (mpfr_exp_t,
@@ -499,5 +637,5 @@ mpc_mul (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
    else
       return ((MPC_MAX_PREC(a)
                <= (mpfr_prec_t) MUL_KARATSUBA_THRESHOLD * BITS_PER_MP_LIMB)
-            ? mpc_mul_naive : mpc_mul_karatsuba) (a, b, c, rnd);
+            ? mpc_mul_naive : mpc_mul_karatsuba3) (a, b, c, rnd);
 }
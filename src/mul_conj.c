@@ -0,0 +1,46 @@
+/* mpc_mul_conj -- Multiply a complex number by the conjugate of another.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* a <- b * conj(c) */
+int
+mpc_mul_conj (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
+{
+   mpc_t c_conj;
+   int inex;
+
+   if (a != c) {
+      /* create the conjugate of c in c_conj without allocating new memory,
+         as in mpc_div; since a is different from c, c_conj is read-only
+         in mpc_mul */
+      mpc_realref (c_conj)[0] = mpc_realref (c)[0];
+      mpc_imagref (c_conj)[0] = mpc_imagref (c)[0];
+      MPFR_CHANGE_SIGN (mpc_imagref (c_conj));
+      return mpc_mul (a, b, c_conj, rnd);
+   }
+
+   mpc_init3 (c_conj, MPC_PREC_RE (c), MPC_PREC_IM (c));
+   mpc_conj (c_conj, c, MPC_RNDNN); /* exact */
+   inex = mpc_mul (a, b, c_conj, rnd);
+   mpc_clear (c_conj);
+
+   return inex;
+}
@@ -1,6 +1,6 @@
 /* mpc_norm -- Square of the norm of a complex number.
 
-Copyright (C) 2002, 2005, 2008, 2009, 2010, 2011, 2012 INRIA
+Copyright (C) 2002, 2005, 2008, 2009, 2010, 2011, 2012, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -49,6 +49,9 @@ mpc_norm (mpfr_ptr a, mpc_srcptr b, mpfr_rnd_t rnd)
       const int max_loops = 2;
          /* switch to exact squarings when loops==max_loops */
 
+      if (mpc_norm_limbs (a, b, rnd, &inexact))
+         return inexact;
+
       prec = mpfr_get_prec (a);
 
       mpfr_init (u);
@@ -1,6 +1,6 @@
 /* mpc_pow -- Raise a complex number to the power of another complex number.
 
-Copyright (C) 2009, 2010, 2011, 2012, 2014, 2015, 2016, 2018, 2020, 2022, 2024, 2025 INRIA
+Copyright (C) 2009, 2010, 2011, 2012, 2014, 2015, 2016, 2018, 2020, 2022, 2024, 2025, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -756,8 +756,8 @@ mpc_pow (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
               Ziv's strategy; probably wrong now since q is not computed */
   if (p < 64)
     p = 64;
-  mpc_init2 (u, p);
-  mpc_init2 (t, p);
+  mpc_tmp_init2 (u, p);
+  mpc_tmp_init2 (t, p);
   pr += MPC_RND_RE(rnd) == MPFR_RNDN;
   pi += MPC_RND_IM(rnd) == MPFR_RNDN;
   maxprec = MPC_MAX_PREC (z);
@@ -954,8 +954,8 @@ mpc_pow (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
   else
     ret = mpc_set (z, u, rnd);
  exact:
-  mpc_clear (t);
-  mpc_clear (u);
+  mpc_tmp_clear (t);
+  mpc_tmp_clear (u);
 
   /* restore underflow and overflow flags from MPFR */
   if (saved_underflow)
@@ -1,6 +1,6 @@
 /* mpc_pow_ui -- Raise a complex number to an integer power.
 
-Copyright (C) 2009, 2010, 2011, 2012 INRIA
+Copyright (C) 2009, 2010, 2011, 2012, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -21,18 +21,36 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 #include <limits.h> /* for CHAR_BIT */
 #include "mpc-impl.h"
 
+/* Exponents handled by mpc_pow_window are given either as an unsigned long
+   or as a non-negative mpz_t, to avoid an allocation for the former. */
+#define POW_BIT(yz,yu,i) \
+   ((yz) != NULL ? mpz_tstbit ((yz), (i)) : (int) (((yu) >> (i)) & 1))
+
+/* largest window size, so that the table of odd powers of x has at most
+   2^(POW_WINDOW_MAX-1) entries */
+#define POW_WINDOW_MAX 6
+
 static int
-mpc_pow_usi_naive (mpc_ptr z, mpc_srcptr x, unsigned long y, int sign,
-   mpc_rnd_t rnd)
+mpc_pow_naive (mpc_ptr z, mpc_srcptr x, mpz_srcptr yz, unsigned long yu,
+   int sign, mpc_rnd_t rnd)
 {
    int inex;
    mpc_t t;
 
-   mpc_init3 (t, sizeof (unsigned long) * CHAR_BIT, MPFR_PREC_MIN);
-   if (sign > 0)
-      mpc_set_ui (t, y, MPC_RNDNN); /* exact */
-   else
-      mpc_set_si (t, - (signed long) y, MPC_RNDNN);
+   if (yz != NULL) {
+      mpfr_prec_t n = (mpfr_prec_t) mpz_sizeinbase (yz, 2);
+      mpc_init3 (t, (n < MPFR_PREC_MIN) ? MPFR_PREC_MIN : n, MPFR_PREC_MIN);
+      mpc_set_z (t, yz, MPC_RNDNN); /* exact */
+      if (sign < 0)
+         mpfr_neg (mpc_realref (t), mpc_realref (t), MPFR_RNDN);
+   }
+   else {
+      mpc_init3 (t, sizeof (unsigned long) * CHAR_BIT, MPFR_PREC_MIN);
+      if (sign > 0)
+         mpc_set_ui (t, yu, MPC_RNDNN); /* exact */
+      else
+         mpc_set_si (t, - (signed long) yu, MPC_RNDNN);
+   }
    inex = mpc_pow (z, x, t, rnd);
    mpc_clear (t);
 
@@ -40,82 +58,121 @@ mpc_pow_usi_naive (mpc_ptr z, mpc_srcptr x, unsigned long y, int sign,
 }
 
 
-int
-mpc_pow_usi (mpc_ptr z, mpc_srcptr x, unsigned long y, int sign,
-   mpc_rnd_t rnd)
-   /* computes z = x^(sign*y) */
+static int
+pow_window_size (mpfr_prec_t l0)
+   /* Return the window size minimising roughly the number
+      2^(k-1) + l0/(k+1) of multiplications for an exponent of l0 bits. */
+{
+   if (l0 <= 4)
+      return 1;
+   else if (l0 <= 24)
+      return 2;
+   else if (l0 <= 80)
+      return 3;
+   else if (l0 <= 240)
+      return 4;
+   else if (l0 <= 672)
+      return 5;
+   else
+      return POW_WINDOW_MAX;
+}
+
+
+static int
+mpc_pow_window (mpc_ptr z, mpc_srcptr x, mpz_srcptr yz, unsigned long yu,
+   int sign, mpc_rnd_t rnd)
+   /* computes z = x^(sign*y) with y > 1 given by yz if it is not NULL and
+      by yu otherwise, by left-to-right sliding window exponentiation;
+      the odd powers x^(2j+1) for 0 <= j < 2^(k-1) are precomputed, and
+      each window of at most k bits of y ending with a 1 costs one
+      multiplication. */
 {
    int inex;
-   mpc_t t, x3;
-   mpfr_prec_t p, l, l0;
-   long unsigned int u;
-   int has3; /* non-zero if y has '11' in its binary representation */
-   int loop, done;
+   mpc_t t, x2, tab [1 << (POW_WINDOW_MAX - 1)];
+   mpc_srcptr cur;
+   mpfr_prec_t p, l0, i, j, b;
+   unsigned long u, ymag, w;
+   int k, ntab, loop, done;
 
-   /* let mpc_pow deal with special values */
-   if (!mpc_fin_p (x) || mpfr_zero_p (mpc_realref (x)) || mpfr_zero_p (mpc_imagref(x))
-       || y == 0)
-      return mpc_pow_usi_naive (z, x, y, sign, rnd);
-   /* easy special cases */
-   else if (y == 1) {
-      if (sign > 0)
-         return mpc_set (z, x, rnd);
-      else
-         return mpc_ui_div (z, 1ul, x, rnd);
-   }
-   else if (y == 2 && sign > 0)
-      return mpc_sqr (z, x, rnd);
    /* let mpc_pow treat potential over- and underflows */
-   else {
+   {
       mpfr_exp_t exp_r = mpfr_get_exp (mpc_realref (x)),
                  exp_i = mpfr_get_exp (mpc_imagref (x));
-      if (   MPC_MAX (exp_r, exp_i) > mpfr_get_emax () / (mpfr_exp_t) y
+      ymag = (yz == NULL ? yu
+              : mpz_fits_ulong_p (yz) ? mpz_get_ui (yz) : ULONG_MAX);
+      if (   MPC_MAX (exp_r, exp_i)
+             > (mpfr_exp_t) ((unsigned long) mpfr_get_emax () / ymag)
              /* heuristic for overflow */
-          || MPC_MAX (-exp_r, -exp_i) > (-mpfr_get_emin ()) / (mpfr_exp_t) y
+          || MPC_MAX (-exp_r, -exp_i)
+             > (mpfr_exp_t) ((unsigned long) (-mpfr_get_emin ()) / ymag)
              /* heuristic for underflow */
          )
-         return mpc_pow_usi_naive (z, x, y, sign, rnd);
+         return mpc_pow_naive (z, x, yz, yu, sign, rnd);
    }
 
-   has3 = (y & (y >> 1)) != 0;
-   for (l = 0, u = y; u > 3; l ++, u >>= 1);
-   /* l>0 is the number of bits of y, minus 2, thus y has bits:
-      y_{l+1} y_l y_{l-1} ... y_1 y_0 */
-   l0 = l + 2;
+   if (yz != NULL)
+      l0 = (mpfr_prec_t) mpz_sizeinbase (yz, 2);
+   else
+      for (l0 = 0, u = yu; u != 0; l0++, u >>= 1);
+   /* l0 is the number of bits of y, so that y < 2^l0 */
+   k = pow_window_size (l0);
+   ntab = 1 << (k - 1);
    p = MPC_MAX_PREC(z) + l0 + 32; /* l0 ensures that y*2^{-p} <= 1 below */
    mpc_init2 (t, p);
-   if (has3)
-      mpc_init2 (x3, p);
+   if (k > 1)
+      mpc_init2 (x2, p);
+   for (j = 1; j < ntab; j++)
+      mpc_init2 (tab [j], p);
 
    loop = 0;
    done = 0;
    while (!done) {
       loop++;
 
-      mpc_sqr (t, x, MPC_RNDNN);
-      if (has3) {
-         mpc_mul (x3, t, x, MPC_RNDNN);
-         if ((y >> l) & 1) /* y starts with 11... */
-            mpc_set (t, x3, MPC_RNDNN);
+      /* all the computed powers form an addition chain for y, so that the
+         error analysis of algorithms.tex applies */
+      if (k > 1) {
+         mpc_sqr (x2, x, MPC_RNDNN);
+         for (j = 1; j < ntab; j++)
+            mpc_mul (tab [j], (j == 1 ? x : tab [j - 1]), x2, MPC_RNDNN);
       }
-      while (l-- > 0) {
-         mpc_sqr (t, t, MPC_RNDNN);
-         if ((y >> l) & 1) {
-            if ((l > 0) && ((y >> (l-1)) & 1)) /* implies has3 <> 0 */ {
-               l--;
-               mpc_sqr (t, t, MPC_RNDNN);
-               mpc_mul (t, t, x3, MPC_RNDNN);
+      cur = NULL;
+      for (i = l0 - 1; i >= 0; i = j - 1) {
+         if (!POW_BIT (yz, yu, i)) {
+            mpc_sqr (t, cur, MPC_RNDNN);
+            cur = t;
+            j = i;
+            continue;
+         }
+         /* the window y_i ... y_j of at most k bits, where y_j = 1 */
+         for (j = MPC_MAX (i - k + 1, 0); !POW_BIT (yz, yu, j); j++);
+         for (w = 0, b = i; b >= j; b--)
+            w = 2 * w + POW_BIT (yz, yu, b);
+         if (cur == NULL)
+            /* leading window */
+            cur = (w == 1 ? x : tab [w / 2]);
+         else {
+            for (b = i; b >= j; b--) {
+               mpc_sqr (t, cur, MPC_RNDNN);
+               cur = t;
             }
-            else
-               mpc_mul (t, t, x, MPC_RNDNN);
+            mpc_mul (t, t, (w == 1 ? x : tab [w / 2]), MPC_RNDNN);
          }
+         /* stop early in case of overflow, which is then handled by
+            mpc_pow below */
+         if (!mpc_fin_p (cur))
+            break;
       }
+      if (cur != t)
+         /* y = 2j+1 < 2^k, exact */
+         mpc_set (t, cur, MPC_RNDNN);
       if (sign < 0)
          mpc_ui_div (t, 1ul, t, MPC_RNDNN);
 
-      if (mpfr_zero_p (mpc_realref(t)) || mpfr_zero_p (mpc_imagref(t))) {
-         inex = mpc_pow_usi_naive (z, x, y, sign, rnd);
-            /* since mpfr_get_exp() is not defined for zero */
+      if (!mpc_fin_p (t)
+          || mpfr_zero_p (mpc_realref(t)) || mpfr_zero_p (mpc_imagref(t))) {
+         inex = mpc_pow_naive (z, x, yz, yu, sign, rnd);
+            /* since mpfr_get_exp() is not defined for zero and infinities */
          done = 1;
       }
       else {
@@ -142,26 +199,66 @@ mpc_pow_usi (mpc_ptr z, mpc_srcptr x, unsigned long y, int sign,
             /* common case, make a second trial at higher precision */
             p += MPC_MAX_PREC(x);
             mpc_set_prec (t, p);
-            if (has3)
-               mpc_set_prec (x3, p);
-            l = l0 - 2;
+            if (k > 1)
+               mpc_set_prec (x2, p);
+            for (j = 1; j < ntab; j++)
+               mpc_set_prec (tab [j], p);
          }
          else {
             /* stop the loop and use mpc_pow */
-            inex = mpc_pow_usi_naive (z, x, y, sign, rnd);
+            inex = mpc_pow_naive (z, x, yz, yu, sign, rnd);
             done = 1;
          }
       }
    }
 
+   for (j = ntab - 1; j >= 1; j--)
+      mpc_clear (tab [j]);
+   if (k > 1)
+      mpc_clear (x2);
    mpc_clear (t);
-   if (has3)
-      mpc_clear (x3);
 
    return inex;
 }
 
 
+int
+mpc_pow_usi (mpc_ptr z, mpc_srcptr x, unsigned long y, int sign,
+   mpc_rnd_t rnd)
+   /* computes z = x^(sign*y) */
+{
+   /* let mpc_pow deal with special values */
+   if (!mpc_fin_p (x) || mpfr_zero_p (mpc_realref (x))
+       || mpfr_zero_p (mpc_imagref (x)) || y == 0)
+      return mpc_pow_naive (z, x, NULL, y, sign, rnd);
+   /* easy special cases */
+   else if (y == 1) {
+      if (sign > 0)
+         return mpc_set (z, x, rnd);
+      else
+         return mpc_ui_div (z, 1ul, x, rnd);
+   }
+   else if (y == 2 && sign > 0)
+      return mpc_sqr (z, x, rnd);
+   else
+      return mpc_pow_window (z, x, NULL, y, sign, rnd);
+}
+
+
+int
+mpc_pow_usz (mpc_ptr z, mpc_srcptr x, mpz_srcptr y, int sign,
+   mpc_rnd_t rnd)
+   /* computes z = x^(sign*y) for y > 2 */
+{
+   /* let mpc_pow deal with special values */
+   if (!mpc_fin_p (x) || mpfr_zero_p (mpc_realref (x))
+       || mpfr_zero_p (mpc_imagref (x)))
+      return mpc_pow_naive (z, x, y, 0, sign, rnd);
+   else
+      return mpc_pow_window (z, x, y, 0, sign, rnd);
+}
+
+
 int
 mpc_pow_ui (mpc_ptr z, mpc_srcptr x, unsigned long y, mpc_rnd_t rnd)
 {
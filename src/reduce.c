@@ -0,0 +1,141 @@
+/* mpc_reduce_pi_2, mpc_sin_cos_fr -- Argument reduction for large real
+   arguments of trigonometric functions.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+static void
+const_pi_2 (mpfr_ptr rop)
+   /* Set rop to pi/2 rounded to nearest, from the cached value of pi. */
+{
+   mpc_const_pi (rop, MPFR_RNDN);
+   mpfr_div_2ui (rop, rop, 1, MPFR_RNDN);
+}
+
+int
+mpc_reduce_pi_2 (mpfr_ptr r, mpfr_srcptr x)
+   /* For a regular x with an exponent of at least 2, let k be an integer
+      such that rho = x - k*pi/2 satisfies |rho| < 0.79; set r to an
+      approximation of rho with |r - rho| <= 2^(1-p) |rho|, where p is the
+      precision of r, and return k mod 4. */
+{
+   mpfr_t h, t, u;
+   mpz_t k;
+   mpfr_exp_t e = mpfr_get_exp (x);
+   mpfr_prec_t p = mpfr_get_prec (r), prec;
+   int q;
+
+   /* Let h be pi/2 with an error of at most 1 ulp = 2^(1-prec), and let
+      |k| < 2^e, which holds for e >= 2. Then D = x - k*h is computed
+      exactly and differs from rho by at most 2^(e+1-prec); its rounding r
+      satisfies |r - rho| <= 2^(1-p) |rho| as soon as this error is at
+      most 2^(Exp(r)-p-3). This is ensured by the loop, which terminates
+      since rho is not zero. The quotient x/h is computed with an error
+      of at most 2^(-9), so that k is the nearest integer to x/(pi/2) up
+      to 2^(-9), and |rho| <= (1/2 + 2^(-9)) pi/2 < 0.79. */
+   prec = e + p + 10;
+   mpfr_init2 (h, prec);
+   mpfr_init2 (t, e + 10);
+   mpfr_init2 (u, 2);
+   mpz_init (k);
+   const_pi_2 (h);
+   mpfr_div (t, x, h, MPFR_RNDN);
+   mpfr_get_z (k, t, MPFR_RNDN);
+   q = (int) mpz_fdiv_ui (k, 4);
+   for (;;) {
+      mpfr_set_prec (u, prec + mpz_sizeinbase (k, 2));
+      mpfr_mul_z (u, h, k, MPFR_RNDN); /* exact */
+      mpfr_sub (r, x, u, MPFR_RNDN);
+      if (!mpfr_zero_p (r) && prec >= e + p + 4 - mpfr_get_exp (r))
+         break;
+      if (mpfr_zero_p (r))
+         prec += prec;
+      else
+         prec = e + p + 4 - mpfr_get_exp (r) + mpc_ceil_log2 (prec);
+      mpfr_set_prec (h, prec);
+      const_pi_2 (h);
+   }
+   mpz_clear (k);
+   mpfr_clear (u);
+   mpfr_clear (t);
+   mpfr_clear (h);
+
+   return q;
+}
+
+int
+mpc_sin_cos_fr (mpfr_ptr s, mpfr_ptr c, mpfr_srcptr x)
+   /* Set s to sin(x) and c to cos(x); one of them may be NULL, in which
+      case it is not computed. If x has an exponent of at most
+      TRIG_REDUCE_EXP or is not a regular number, s and c are rounded to
+      nearest by mpfr_sin_cos and 0 is returned. Otherwise the argument
+      is first reduced by mpc_reduce_pi_2 with pi taken from a cache,
+      which avoids recomputing pi at each call and at each iteration of
+      the calling Ziv loop, and 1 is returned; then s and c have a
+      relative error of at most 2^(2-p), where p is their precision. */
+{
+   mpfr_t r;
+   mpfr_ptr sr, cr;
+   mpfr_prec_t p;
+   int q;
+
+   if (!mpfr_regular_p (x) || mpfr_get_exp (x) <= TRIG_REDUCE_EXP) {
+      if (s == NULL)
+         mpfr_cos (c, x, MPFR_RNDN);
+      else if (c == NULL)
+         mpfr_sin (s, x, MPFR_RNDN);
+      else
+         mpfr_sin_cos (s, c, x, MPFR_RNDN);
+      return 0;
+   }
+
+   /* Let rho be the exact reduced argument, with |rho| < 0.79. Then
+      |r - rho| <= 2^(1-p) |rho| <= 1.12 * 2^(1-p) |sin(rho)|, so that
+      sin(r), rounded to nearest, has a relative error of at most
+      3.3 * 2^(-p) with respect to sin(rho); and since
+      |cos(r) - cos(rho)| <= sin(0.79) |r - rho| <= 1.14 * 2^(-p) and
+      cos(rho) >= 0.7, the same holds for cos(r). */
+   if (s == NULL)
+      p = mpfr_get_prec (c);
+   else if (c == NULL)
+      p = mpfr_get_prec (s);
+   else
+      p = MPC_MAX (mpfr_get_prec (s), mpfr_get_prec (c));
+   mpfr_init2 (r, p);
+   q = mpc_reduce_pi_2 (r, x);
+
+   /* sin(x) = sin(r), cos(r), -sin(r), -cos(r) and
+      cos(x) = cos(r), -sin(r), -cos(r), sin(r) for q = 0, 1, 2, 3 */
+   sr = (q & 1) ? c : s;
+   cr = (q & 1) ? s : c;
+   if (sr == NULL)
+      mpfr_cos (cr, r, MPFR_RNDN);
+   else if (cr == NULL)
+      mpfr_sin (sr, r, MPFR_RNDN);
+   else
+      mpfr_sin_cos (sr, cr, r, MPFR_RNDN);
+   if (s != NULL && q >= 2)
+      mpfr_neg (s, s, MPFR_RNDN);
+   if (c != NULL && (q == 1 || q == 2))
+      mpfr_neg (c, c, MPFR_RNDN);
+   mpfr_clear (r);
+
+   return 1;
+}
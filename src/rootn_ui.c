@@ -0,0 +1,540 @@
+/* mpc_rootn_ui -- n-th root of a complex number.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <math.h>
+#include "mpc-impl.h"
+
+/* Set t to x^n for n >= 1 by left-to-right binary exponentiation, all
+   operations being rounded to nearest at the precision of t, so that the
+   relative error is at most (1 + 2^(-p))^n - 1 with p = prec (t).
+   Return non-zero if all operations are exact. */
+static int
+pow_approx (mpc_ptr t, mpc_srcptr x, unsigned long n)
+{
+   int i, exact;
+
+   for (i = 0; (n >> i) > 1; i++);
+   exact = (mpc_set (t, x, MPC_RNDNN) == 0);
+   for (i--; i >= 0; i--) {
+      exact &= (mpc_sqr (t, t, MPC_RNDNN) == 0);
+      if ((n >> i) & 1)
+         exact &= (mpc_mul (t, t, x, MPC_RNDNN) == 0);
+   }
+   return exact;
+}
+
+/* Set rop to s * (c * |a|^k / 2^d)^(1/n) rounded according to rnd, where
+   a is a non-zero real number, s = 1 or -1, k = 1 or 2, c = 1 or 27 and
+   n is small. The argument of the root is formed exactly, splitting off
+   its exponent to avoid overflow. */
+static int
+root_part (mpfr_ptr rop, mpfr_srcptr a, int k, unsigned long c, long d,
+           unsigned long n, int s, mpfr_rnd_t rnd)
+{
+   mpfr_t t;
+   mpfr_exp_t e, q, r;
+   int inex;
+
+   mpc_tmp_fr_init2 (t, k * mpfr_get_prec (a) + 5);
+   mpfr_abs (t, a, MPFR_RNDN);
+   e = mpfr_get_exp (a);
+   mpfr_set_exp (t, 0);
+   if (k == 2)
+      mpfr_sqr (t, t, MPFR_RNDN);
+   mpfr_mul_ui (t, t, c, MPFR_RNDN);
+
+   /* the argument is t * 2^(k*e - d) = t * 2^(q*n + r) with 0 <= r < n;
+      compute q and r from e = q0*n + r0 to avoid an overflow in k*e */
+   q = e / (long) n;
+   r = e % (long) n;
+   if (r < 0) {
+      q--;
+      r += n;
+   }
+   q *= k;
+   r = k * r - d;
+   q += r / (long) n;
+   r %= (long) n;
+   if (r < 0) {
+      q--;
+      r += n;
+   }
+   mpfr_mul_2si (t, t, r, MPFR_RNDN);
+
+   inex = mpfr_rootn_ui (rop, t, n, s > 0 ? rnd : INV_RND (rnd));
+   mpfr_mul_2si (rop, rop, q, MPFR_RNDN);
+   if (s < 0) {
+      mpfr_neg (rop, rop, MPFR_RNDN);
+      inex = -inex;
+   }
+
+   mpc_tmp_fr_clear (t);
+
+   return inex;
+}
+
+/* Return arg (z) computed in double precision, and set *e and *rho to an
+   exponent and a double such that |z| = 2^e * rho with 1/2 <= rho < 2,
+   without overflow or underflow. */
+static double
+arg_d (long *e, double *rho, mpc_srcptr z)
+{
+   double xs, ys;
+   long ex, ey;
+
+   xs = mpfr_get_d_2exp (&ex, mpc_realref (z), MPFR_RNDN);
+   ys = mpfr_get_d_2exp (&ey, mpc_imagref (z), MPFR_RNDN);
+   if (mpfr_zero_p (mpc_realref (z))) {
+      xs = (mpfr_signbit (mpc_realref (z)) ? -0.0 : 0.0);
+      ex = ey;
+   }
+   if (mpfr_zero_p (mpc_imagref (z))) {
+      ys = (mpfr_signbit (mpc_imagref (z)) ? -0.0 : 0.0);
+      ey = ex;
+   }
+   *e = MPC_MAX (ex, ey);
+   xs = ldexp (xs, (int) MPC_MAX (ex - *e, -2000));
+   ys = ldexp (ys, (int) MPC_MAX (ey - *e, -2000));
+   *rho = sqrt (xs * xs + ys * ys);
+
+   return atan2 (ys, xs);
+}
+
+/* Set w to an approximation of the principal n-th root of z; if prec is 0,
+   it is computed in double precision with a relative error of about
+   2^(-50), otherwise as exp (log (z) / n) at precision prec. */
+static void
+root_seed (mpc_ptr w, mpc_srcptr z, unsigned long n, mpfr_prec_t prec)
+{
+   double rho, l, th;
+   long e, q;
+   unsigned long r, m;
+   mpc_t lz;
+
+   if (prec == 0) {
+      th = arg_d (&e, &rho, z) / (double) n;
+
+      /* |z| = 2^e * rho with e = q*n + r and 0 <= r < n */
+      if (e >= 0) {
+         q = (long) ((unsigned long) e / n);
+         r = (unsigned long) e % n;
+      }
+      else {
+         m = - (unsigned long) e;
+         q = - (long) (m / n);
+         r = m % n;
+         if (r != 0) {
+            q--;
+            r = n - r;
+         }
+      }
+
+      l = exp ((log (rho) + (double) r * M_LN2) / (double) n);
+      mpfr_set_d (mpc_realref (w), l * cos (th), MPFR_RNDN);
+      mpfr_set_d (mpc_imagref (w), l * sin (th), MPFR_RNDN);
+      mpc_mul_2si (w, w, q, MPC_RNDNN);
+   }
+   else {
+      mpc_init2 (lz, prec);
+      mpc_log (lz, z, MPC_RNDNN);
+      mpc_div_ui (lz, lz, n, MPC_RNDNN);
+      mpc_exp (w, lz, MPC_RNDNN);
+      mpc_clear (lz);
+   }
+}
+
+/* Return non-zero if |n * arg (w) - arg (z)| < 5. If moreover w^n = z (1 - eta)
+   with |eta| <= 1/2, then the n-th root w (1 - eta)^(1/n) of z, with
+   |arg (1 - eta)| <= pi/6, has argument arg (z) / n for n >= 3, so that it
+   is the principal root. The arguments are computed in double precision
+   for n <= 2^30, which leaves a margin of more than 0.7 for their errors. */
+static int
+root_principal (mpc_srcptr w, mpc_srcptr z, unsigned long n, int cl2n)
+{
+   mpfr_t a, b;
+   double rho;
+   long e;
+   int ok;
+
+   if (cl2n <= 30)
+      return fabs ((double) n * arg_d (&e, &rho, w) - arg_d (&e, &rho, z))
+             < 5.0;
+
+   mpc_tmp_fr_init2 (a, cl2n + 64);
+   mpc_tmp_fr_init2 (b, cl2n + 64);
+   mpfr_atan2 (a, mpc_imagref (w), mpc_realref (w), MPFR_RNDN);
+   mpfr_mul_ui (a, a, n, MPFR_RNDN);
+   mpfr_atan2 (b, mpc_imagref (z), mpc_realref (z), MPFR_RNDN);
+   mpfr_sub (a, a, b, MPFR_RNDN);
+   ok = (mpfr_cmpabs_ui (a, 5) < 0);
+   mpc_tmp_fr_clear (b);
+   mpc_tmp_fr_clear (a);
+
+   return ok;
+}
+
+/* Round the parts of w to the nearest multiples of 2^e, and check whether
+   the result a satisfies a^n = z, computing a^n with precision pv. If so,
+   set rop to a rounded according to rnd, set *inex to the ternary value
+   and return non-zero. */
+static int
+root_exact (mpc_ptr rop, int *inex, mpc_srcptr w, mpc_srcptr z,
+            unsigned long n, mpfr_exp_t e, mpfr_prec_t pv, mpc_rnd_t rnd)
+{
+   mpc_t a, b;
+   mpfr_t t;
+   mpfr_exp_t ea;
+   int ok;
+
+   ea = e;
+   if (!mpfr_zero_p (mpc_realref (w)))
+      ea = MPC_MAX (ea, mpfr_get_exp (mpc_realref (w)));
+   if (!mpfr_zero_p (mpc_imagref (w)))
+      ea = MPC_MAX (ea, mpfr_get_exp (mpc_imagref (w)));
+   mpc_init2 (a, ea - e + 2);
+   mpc_tmp_fr_init2 (t, MPC_MAX_PREC (w));
+   mpfr_mul_2si (t, mpc_realref (w), -e, MPFR_RNDN);
+   mpfr_rint (mpc_realref (a), t, MPFR_RNDN);
+   mpfr_mul_2si (mpc_realref (a), mpc_realref (a), e, MPFR_RNDN);
+   mpfr_mul_2si (t, mpc_imagref (w), -e, MPFR_RNDN);
+   mpfr_rint (mpc_imagref (a), t, MPFR_RNDN);
+   mpfr_mul_2si (mpc_imagref (a), mpc_imagref (a), e, MPFR_RNDN);
+   mpc_tmp_fr_clear (t);
+
+   mpc_init2 (b, MPC_MAX (pv, mpc_get_prec (a)));
+   ok = pow_approx (b, a, n) && mpc_cmp (b, z) == 0;
+   if (ok)
+      *inex = mpc_set (rop, a, rnd);
+   mpc_clear (b);
+   mpc_clear (a);
+
+   return ok;
+}
+
+int
+mpc_rootn_ui (mpc_ptr rop, mpc_srcptr op, unsigned long n, mpc_rnd_t rnd)
+{
+   mpfr_srcptr x = mpc_realref (op), y = mpc_imagref (op);
+   mpc_t w, t, c, d;
+   mpfr_t th;
+   mpfr_prec_t prec, p, pc, pv, good, seed_prec, steps[8 * sizeof (mpfr_prec_t)];
+   mpfr_exp_t ez, lz, e_min, eR, eS, eW, eeta, erho, m, err_abs, ea_re, ea_im;
+   mpfr_exp_t err_re, err_im, lost;
+   int cl2n, fl2n, k, j, loop, exact_tried, zero_r, ok_re, ok_im, s;
+   int inex, inex_re, inex_im;
+   mpfr_exp_t saved_emin, saved_emax;
+
+   if (n == 0) {
+      mpfr_set_nan (mpc_realref (rop));
+      mpfr_set_nan (mpc_imagref (rop));
+      return MPC_INEX (0, 0);
+   }
+   else if (n == 1)
+      return mpc_set (rop, op, rnd);
+   else if (n == 2)
+      return mpc_sqrt (rop, op, rnd);
+
+   /* special values: for n >= 3, the argument of the root lies in
+      (-pi/3, pi/3], so that its real part is positive */
+   if (!mpc_fin_p (op)) {
+      if (mpfr_inf_p (x) || mpfr_inf_p (y)) {
+         /* set the imaginary part first, since it depends on x */
+         if (mpfr_nan_p (y))
+            mpfr_set_nan (mpc_imagref (rop));
+         else if (mpfr_inf_p (y) || mpfr_sgn (x) < 0)
+            mpfr_set_inf (mpc_imagref (rop), MPFR_SIGN (y));
+         else
+            mpfr_set_zero (mpc_imagref (rop), MPFR_SIGN (y));
+         mpfr_set_inf (mpc_realref (rop), +1);
+      }
+      else {
+         mpfr_set_nan (mpc_realref (rop));
+         mpfr_set_nan (mpc_imagref (rop));
+      }
+      return MPC_INEX (0, 0);
+   }
+
+   if (mpfr_zero_p (y) && mpfr_sgn (x) >= 0) {
+      /* the root of a non-negative real number is real, and the root of
+         zero is +0 + i*y as for mpc_sqrt */
+      if (mpfr_zero_p (x)) {
+         mpfr_set_zero (mpc_realref (rop), +1);
+         inex_re = 0;
+      }
+      else
+         inex_re = mpfr_rootn_ui (mpc_realref (rop), x, n, MPC_RND_RE (rnd));
+      inex_im = mpfr_set (mpc_imagref (rop), y, MPC_RND_IM (rnd));
+      return MPC_INEX (inex_re, inex_im);
+   }
+
+   saved_emin = mpfr_get_emin ();
+   saved_emax = mpfr_get_emax ();
+   mpfr_set_emin (mpfr_get_emin_min ());
+   mpfr_set_emax (mpfr_get_emax_max ());
+
+   if ((mpfr_zero_p (y) && (n == 3 || n == 4 || n == 6))
+       || (mpfr_zero_p (x) && n == 3)) {
+      /* The root r e^(i pi/n) of a negative real number, or the root
+         r e^(+-i pi/6) of a purely imaginary number for n = 3, may have
+         an exact real or imaginary part, so that a Ziv loop need not
+         terminate; its parts are obtained by a real root of exact
+         numbers instead, since cos (pi/3) = sin (pi/6) = 1/2,
+         cos (pi/4)^4 = 1/4 and cos (pi/6)^6 = 27/64. The part of rop
+         that does not alias the non-zero part of op is set first. */
+      s = (mpfr_signbit (y) ? -1 : +1);
+      if (mpfr_zero_p (x)) {
+         inex_re = root_part (mpc_realref (rop), y, 2, 27, 6, 6, +1,
+                              MPC_RND_RE (rnd));
+         inex_im = root_part (mpc_imagref (rop), y, 1, 1, 3, 3, s,
+                              MPC_RND_IM (rnd));
+      }
+      else if (n == 3) {
+         inex_im = root_part (mpc_imagref (rop), x, 2, 27, 6, 6, s,
+                              MPC_RND_IM (rnd));
+         inex_re = root_part (mpc_realref (rop), x, 1, 1, 3, 3, +1,
+                              MPC_RND_RE (rnd));
+      }
+      else if (n == 4) {
+         inex_im = root_part (mpc_imagref (rop), x, 1, 1, 2, 4, s,
+                              MPC_RND_IM (rnd));
+         inex_re = root_part (mpc_realref (rop), x, 1, 1, 2, 4, +1,
+                              MPC_RND_RE (rnd));
+      }
+      else {
+         inex_im = root_part (mpc_imagref (rop), x, 1, 1, 6, 6, s,
+                              MPC_RND_IM (rnd));
+         inex_re = root_part (mpc_realref (rop), x, 1, 27, 6, 6, +1,
+                              MPC_RND_RE (rnd));
+      }
+      goto end;
+   }
+
+   /* The root is computed by Newton's iteration w <- w - (w^n - z) / (n
+      w^(n-1)), doubling the working precision at each step, from a seed
+      computed in double precision; for large n, whose roots are too
+      close for double precision, the seed is computed by mpc_log and
+      mpc_exp.
+      The error is bounded a posteriori from the residual of the last but
+      one iterate W, computed at the final precision P as R = o(S - z)
+      with S = o(W^n), and from the quadratic convergence of the last
+      step. Let u = 2^(-P); then |S - W^n| <= gamma |W^n| with
+      gamma = (1+u)^n - 1 <= 2^(1 + ceil(log2 (n)) - P), and
+      eta = (W^n - z) / W^n satisfies |eta| <= |R| (1+gamma) / ((1-u) |S|)
+      + gamma <= 2^(Exp (R) - Exp (S) + 2) + gamma, with Exp the maximal
+      exponent of the real and imaginary parts. If |eta| <= 1/2, the root
+      w* = W (1 - eta)^(1/n) of z satisfies |w* - W| <= 2 |W| |eta| / n,
+      and it is the principal root by root_principal. The exact Newton
+      step N(W) satisfies |N(W) - w*| <= 2 (n-1) |w* - W|^2 / |W|
+      <= |W| 2^(2 Exp (eta) + 3) / n, and the computed correction
+      C = o(o(R conj (T)) / o(n o(|T|^2))), with T = o(W^(n-1)) and four
+      roundings at precision pc, differs from the exact one by at most
+      |W| / n (|eta| 2^(4 + ceil(log2 (n)) - pc) + gamma). Both parts of the new iterate
+      o(W - C) have an additional error of 1/2 ulp. */
+   for (cl2n = 0; cl2n < 64 && ((n - 1) >> cl2n) != 0; cl2n++);
+   for (fl2n = 0; (n >> fl2n) > 1; fl2n++);
+
+   /* exact roots are multiples of 2^e_min, see root_exact */
+   ez = mpfr_get_emin_min ();
+   lz = mpfr_get_emax_max ();
+   if (!mpfr_zero_p (x)) {
+      ez = mpfr_get_exp (x);
+      lz = mpfr_get_exp (x) - (mpfr_exp_t) mpfr_get_prec (x);
+   }
+   if (!mpfr_zero_p (y)) {
+      ez = MPC_MAX (ez, mpfr_get_exp (y));
+      lz = MPC_MIN (lz, mpfr_get_exp (y) - (mpfr_exp_t) mpfr_get_prec (y));
+   }
+   if (lz >= 0)
+      e_min = (mpfr_exp_t) ((unsigned long) lz / n) - 1;
+   else
+      e_min = - (mpfr_exp_t) ((- (unsigned long) lz - 1) / n) - 2;
+   pv = ez - lz + 8;
+
+   prec = MPC_MAX_PREC (rop);
+   prec += mpc_ceil_log2 (prec) + cl2n + 12;
+   seed_prec = (cl2n <= 30 ? 0 : cl2n + 64);
+   mpc_init2 (w, prec);
+   mpc_init2 (t, prec);
+   mpc_init2 (c, prec);
+   mpc_init2 (d, prec);
+   mpc_tmp_fr_init2 (th, prec);
+   loop = 0;
+   exact_tried = 0;
+   inex = 0;
+
+   for (;;) {
+      if (seed_prec == 0) {
+         mpc_set_prec (w, 53);
+         good = 48;
+      }
+      else {
+         mpc_set_prec (w, seed_prec);
+         good = seed_prec - 8;
+      }
+      root_seed (w, op, n, seed_prec);
+      /* the last but one iterate must not be rounded */
+      prec = MPC_MAX (prec, mpc_get_prec (w));
+
+      /* Starting from an approximation to p bits, a Newton step yields
+         about 2p - ceil(log2 (n)) bits; the last step has precision prec. */
+      k = 0;
+      p = prec;
+      do {
+         steps[k++] = p;
+         p = (p + cl2n + 3) / 2 + 1;
+      } while (p > good);
+
+      eS = eR = eW = 0;
+      zero_r = 0;
+      pc = prec;
+      for (j = k - 1; j >= 0; j--) {
+         p = steps[j];
+         mpc_set_prec (t, p);
+         mpc_set_prec (c, p);
+         pow_approx (t, w, n - 1);
+         mpc_mul (c, t, w, MPC_RNDNN);
+         eS = MPC_MAX (mpfr_get_exp (mpc_realref (c)),
+                       mpfr_get_exp (mpc_imagref (c)));
+         mpc_sub (c, c, op, MPC_RNDNN);
+         zero_r = mpfr_zero_p (mpc_realref (c)) && mpfr_zero_p (mpc_imagref (c));
+         if (!zero_r) {
+            eR = mpfr_get_exp (mpfr_zero_p (mpc_realref (c)) ?
+                               mpc_imagref (c) : mpc_realref (c));
+            if (!mpfr_zero_p (mpc_realref (c)) && !mpfr_zero_p (mpc_imagref (c)))
+               eR = MPC_MAX (eR, mpfr_get_exp (mpc_imagref (c)));
+            /* the correction is smaller than w by a factor of about
+               |R| / |S|, so it need not be computed to the full precision */
+            pc = p + eR - eS + cl2n + 8;
+            pc = MPC_MAX (MPC_MIN (pc, p), MPFR_PREC_MIN);
+            mpc_set_prec (d, pc);
+            mpfr_set_prec (th, pc);
+            mpc_norm (th, t, MPFR_RNDN);
+            mpfr_mul_ui (th, th, n, MPFR_RNDN);
+            mpc_mul_conj (d, c, t, MPC_RNDNN);
+            mpc_div_fr (d, d, th, MPC_RNDNN);
+         }
+         if (j == 0) {
+            eW = MPC_MAX (mpfr_zero_p (mpc_realref (w)) ?
+                          mpfr_get_emin_min () : mpfr_get_exp (mpc_realref (w)),
+                          mpfr_zero_p (mpc_imagref (w)) ?
+                          mpfr_get_emin_min () : mpfr_get_exp (mpc_imagref (w)));
+            if (!root_principal (w, op, n, cl2n))
+               break;
+         }
+         mpfr_prec_round (mpc_realref (w), p, MPFR_RNDN);
+         mpfr_prec_round (mpc_imagref (w), p, MPFR_RNDN);
+         if (!zero_r)
+            mpc_sub (w, w, d, MPC_RNDNN);
+      }
+
+      /* the a posteriori error bound */
+      erho = (zero_r ? mpfr_get_emin_min () : eR - eS + 2);
+      eeta = MPC_MAX (erho, 1 + cl2n - prec) + 1;
+      if (j >= 0 || eeta > -10) {
+         /* the seed is not accurate enough for Newton's iteration to
+            converge to the principal root */
+         seed_prec = (seed_prec == 0 ? cl2n + 64 : 2 * seed_prec);
+         continue;
+      }
+      m = MPC_MAX (2 * eeta + 3, 1 + cl2n - prec);
+      if (!zero_r)
+         m = MPC_MAX (m, erho + 4 + cl2n - pc);
+      err_abs = eW - fl2n + m + 3;
+      ea_re = (mpfr_zero_p (mpc_realref (w)) ? err_abs
+               : MPC_MAX (mpfr_get_exp (mpc_realref (w)) - prec - 1, err_abs) + 1);
+      ea_im = (mpfr_zero_p (mpc_imagref (w)) ? err_abs
+               : MPC_MAX (mpfr_get_exp (mpc_imagref (w)) - prec - 1, err_abs) + 1);
+      err_re = (mpfr_zero_p (mpc_realref (w)) ? 0
+                : mpfr_get_exp (mpc_realref (w)) - ea_re);
+      err_im = (mpfr_zero_p (mpc_imagref (w)) ? 0
+                : mpfr_get_exp (mpc_imagref (w)) - ea_im);
+      ok_re = mpfr_can_round (mpc_realref (w), err_re, MPFR_RNDN, MPFR_RNDZ,
+                 MPC_PREC_RE (rop) + (MPC_RND_RE (rnd) == MPFR_RNDN));
+      ok_im = mpfr_can_round (mpc_imagref (w), err_im, MPFR_RNDN, MPFR_RNDZ,
+                 MPC_PREC_IM (rop) + (MPC_RND_IM (rnd) == MPFR_RNDN));
+
+      if (!ok_re || !ok_im) {
+         if (!exact_tried && MPC_MAX (ea_re, ea_im) < e_min - 1) {
+            /* the error is small enough to determine an exact root */
+            exact_tried = 1;
+            if (root_exact (rop, &inex, w, op, n, e_min, pv, rnd))
+               break;
+         }
+      }
+
+      if (ok_re && !ok_im && !mpfr_zero_p (mpc_imagref (w))
+          && mpfr_get_exp (mpc_realref (w)) - mpfr_get_exp (mpc_imagref (w))
+             > prec / 2) {
+         /* The imaginary part is much smaller than the real part, which
+            happens for z close to the positive real axis; then
+            Im (w*) = Re (w*) tan (arg (z) / n) is obtained with a relative
+            error depending on that of the real part. Let th = o(o(atan2
+            (y, x)) / n) = arg (z) / n (1 + delta) with |delta| <= 2.01 u;
+            as |arg (z) / n| <= pi/3, we have |tan (th) - tan (arg (z) /
+            n)| <= 4 |delta| |tan (arg (z) / n)|. With the relative error
+            of Re (W) with respect to Re (w*) bounded by
+            2^(ea_re - Exp (Re (W)) + 2) and two more roundings, the
+            relative error is at most 2^(max (that, 4 - P) + 1). */
+         mpfr_set_prec (th, prec);
+         mpfr_atan2 (th, y, x, MPFR_RNDN);
+         mpfr_div_ui (th, th, n, MPFR_RNDN);
+         mpfr_tan (th, th, MPFR_RNDN);
+         mpfr_mul (th, th, mpc_realref (w), MPFR_RNDN);
+         err_im = - (MPC_MAX (ea_re - mpfr_get_exp (mpc_realref (w)) + 2,
+                              4 - prec) + 2);
+         if (mpfr_can_round (th, err_im, MPFR_RNDN, MPFR_RNDZ,
+               MPC_PREC_IM (rop) + (MPC_RND_IM (rnd) == MPFR_RNDN))) {
+            mpfr_set_prec (mpc_imagref (w), prec);
+            mpfr_set (mpc_imagref (w), th, MPFR_RNDN);
+            ok_im = 1;
+         }
+      }
+
+      if (ok_re && ok_im) {
+         inex_re = mpfr_set (mpc_realref (rop), mpc_realref (w), MPC_RND_RE (rnd));
+         inex_im = mpfr_set (mpc_imagref (rop), mpc_imagref (w), MPC_RND_IM (rnd));
+         inex = MPC_INEX (inex_re, inex_im);
+         break;
+      }
+
+      /* the first time, add the number of lost bits */
+      lost = MPC_MAX (ok_re ? 0 : prec - err_re, ok_im ? 0 : prec - err_im);
+      if (++loop == 1 && lost > 0)
+         prec += lost;
+      else
+         prec += prec / 2;
+   }
+
+   mpc_tmp_fr_clear (th);
+   mpc_clear (d);
+   mpc_clear (c);
+   mpc_clear (t);
+   mpc_clear (w);
+   inex_re = MPC_INEX_RE (inex);
+   inex_im = MPC_INEX_IM (inex);
+
+ end:
+   mpfr_set_emin (saved_emin);
+   mpfr_set_emax (saved_emax);
+   inex_re = mpfr_check_range (mpc_realref (rop), inex_re, MPC_RND_RE (rnd));
+   inex_im = mpfr_check_range (mpc_imagref (rop), inex_im, MPC_RND_IM (rnd));
+
+   return MPC_INEX (inex_re, inex_im);
+}
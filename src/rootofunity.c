@@ -1,6 +1,7 @@
-/* mpc_rootofunity -- primitive root of unity.
+/* mpc_rootofunity, mpc_rootofunity_table -- primitive root of unity and
+   tables of roots of unity.
 
-Copyright (C) 2012, 2016 INRIA
+Copyright (C) 2012, 2016, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -92,7 +93,7 @@ mpc_rootofunity (mpc_ptr rop, unsigned long n, unsigned long k, mpc_rnd_t rnd)
        rnd_im = MPC_RND_IM (rnd);
        if (k != 1)
          rnd_im = INV_RND (rnd_im);
-       inex_im = mpfr_sqrt_ui (mpc_imagref (rop), 3, rnd_im);
+       inex_im = mpc_const_sqrt3 (mpc_imagref (rop), rnd_im);
        mpc_div_2ui (rop, rop, 1, MPC_RNDNN);
        if (k != 1)
          {
@@ -113,7 +114,7 @@ mpc_rootofunity (mpc_ptr rop, unsigned long n, unsigned long k, mpc_rnd_t rnd)
        rnd_re = MPC_RND_RE (rnd);
        if (k == 5 || k == 7)
          rnd_re = INV_RND (rnd_re);
-       inex_re = mpfr_sqrt_ui (mpc_realref (rop), 3, rnd_re);
+       inex_re = mpc_const_sqrt3 (mpc_realref (rop), rnd_re);
        inex_im = mpfr_set_si (mpc_imagref (rop), k < 6 ? 1 : -1,
                               MPC_RND_IM (rnd));
        mpc_div_2ui (rop, rop, 1, MPC_RNDNN);
@@ -172,7 +173,7 @@ mpc_rootofunity (mpc_ptr rop, unsigned long n, unsigned long k, mpc_rnd_t rnd)
       mpfr_set_prec (s, prec);
       mpfr_set_prec (c, prec);
 
-      mpfr_const_pi (t, MPFR_RNDN);
+      mpc_const_pi (t, MPFR_RNDN);
       mpfr_mul_q (t, t, kn, MPFR_RNDN);
       mpfr_sin_cos (s, c, t, MPFR_RNDN);
    }
@@ -193,3 +194,149 @@ mpc_rootofunity (mpc_ptr rop, unsigned long n, unsigned long k, mpc_rnd_t rnd)
 
    return MPC_INEX(inex_re, inex_im);
 }
+
+/* Set rop to (neg_re ? -a : a) + i*(neg_im ? -b : b) rounded according to
+   rnd, where a and b approximate the parts of exp(2*i*pi*j/n) with an
+   absolute error of at most 2^(-e), if both parts can be rounded;
+   otherwise, and for the roots with an exact part, call mpc_rootofunity.
+   Store the ternary value into inex[j] unless inex is NULL, and set
+   *inexact if it is non-zero. */
+static void
+table_set (mpc_ptr rop, unsigned long n, unsigned long j,
+   mpfr_srcptr a, int neg_re, mpfr_srcptr b, int neg_im, mpfr_exp_t e,
+   int *inex, int *inexact, mpc_rnd_t rnd)
+{
+   int inex_j, inex_re, inex_im;
+
+   if (24 % (n / gcd (j, n)) != 0
+       && mpfr_can_round (a, e + mpfr_get_exp (a), MPFR_RNDN, MPFR_RNDZ,
+                          MPC_PREC_RE (rop) + (MPC_RND_RE (rnd) == MPFR_RNDN))
+       && mpfr_can_round (b, e + mpfr_get_exp (b), MPFR_RNDN, MPFR_RNDZ,
+                          MPC_PREC_IM (rop) + (MPC_RND_IM (rnd) == MPFR_RNDN))) {
+      if (neg_re)
+         inex_re = mpfr_neg (mpc_realref (rop), a, MPC_RND_RE (rnd));
+      else
+         inex_re = mpfr_set (mpc_realref (rop), a, MPC_RND_RE (rnd));
+      if (neg_im)
+         inex_im = mpfr_neg (mpc_imagref (rop), b, MPC_RND_IM (rnd));
+      else
+         inex_im = mpfr_set (mpc_imagref (rop), b, MPC_RND_IM (rnd));
+      inex_j = MPC_INEX (inex_re, inex_im);
+   }
+   else
+      inex_j = mpc_rootofunity (rop, n, j, rnd);
+
+   if (inex != NULL)
+      inex [j] = inex_j;
+   if (inex_j != 0)
+      *inexact = 1;
+}
+
+/* Set rop to i^q * (a + i*b) as in table_set. */
+static void
+table_rotate (mpc_ptr rop, unsigned long n, unsigned long j, int q,
+   mpfr_srcptr a, mpfr_srcptr b, mpfr_exp_t e, int *inex, int *inexact,
+   mpc_rnd_t rnd)
+{
+   if (q & 1)
+      table_set (rop, n, j, b, q == 1, a, q == 3, e, inex, inexact, rnd);
+   else
+      table_set (rop, n, j, a, q == 2, b, q == 2, e, inex, inexact, rnd);
+}
+
+/* put in rop[j] the value of exp(2*i*pi*j/n) rounded according to rnd,
+   for 0 <= j < n */
+int
+mpc_rootofunity_table (mpc_ptr *rop, unsigned long n, int *inex,
+   mpc_rnd_t rnd)
+{
+   mpc_t w;
+   mpfr_t x, y, u, v;
+   mpfr_prec_t prec;
+   mpfr_exp_t e;
+   unsigned long j, k, m, h, q4;
+   int q, inexact = 0;
+
+   if (n == 0)
+      return 0;
+
+   prec = 0;
+   for (j = 0; j < n; j++)
+      prec = MPC_MAX (prec, MPC_MAX_PREC (rop [j]));
+
+   /* The roots are obtained by the symmetries of the unit circle from
+      z_k = exp(2*i*pi*k/n) for 0 <= k <= m, with m = n/8 if n is
+      divisible by 4, n/4 if n is even and n/2 otherwise. For k >= 1,
+      z_k is computed by the recurrence z_k = z_(k-1) * w with
+      w = exp(2*i*pi/n), the parts of each product being correctly
+      rounded to nearest in the working precision p. Then w has an error
+      of at most 2^(-1/2-p) and each product an error of at most
+      2^(1/2-p); for k*2^(-p) <= 2^(-7), the error on z_k is thus at most
+      k*(2^(-1/2) + 2^(1/2))*2^(-p)*(1+2^(-1/2-p))^k <= 2^(ceil(log2(k))+2-p).
+      Since the parts of z_k other than 0 are at least of the order of
+      1/n, respectively 1/n^2 if n is not divisible by 4, log2(n) or
+      2*log2(n) guard bits suffice for them to be rounded in general;
+      the rare parts that cannot be rounded, as well as the roots with an
+      exact part, are computed by mpc_rootofunity. */
+   prec += (n % 4 == 0 ? 1 : 2) * mpc_ceil_log2 ((mpfr_prec_t) n) + 10;
+   m = (n % 4 == 0) ? n / 8 : ((n % 2 == 0) ? n / 4 : n / 2);
+   h = n / 2;
+   q4 = n / 4;
+
+   /* the roots obtained from z_0 = 1 */
+   if (n % 4 == 0)
+      for (q = 0; q < 4; q++)
+         table_set (rop [q * q4], n, q * q4, NULL, 0, NULL, 0, 0, inex,
+                    &inexact, rnd);
+   else {
+      table_set (rop [0], n, 0, NULL, 0, NULL, 0, 0, inex, &inexact, rnd);
+      if (n % 2 == 0)
+         table_set (rop [h], n, h, NULL, 0, NULL, 0, 0, inex, &inexact, rnd);
+   }
+
+   mpc_init2 (w, prec);
+   mpfr_init2 (x, prec);
+   mpfr_init2 (y, prec);
+   mpfr_init2 (u, prec);
+   mpfr_init2 (v, prec);
+   mpc_rootofunity (w, n, 1, MPC_RNDNN);
+   mpfr_set_ui (x, 1, MPFR_RNDN);
+   mpfr_set_ui (y, 0, MPFR_RNDN);
+   for (k = 1; k <= m; k++) {
+      mpfr_fmms (u, x, mpc_realref (w), y, mpc_imagref (w), MPFR_RNDN);
+      mpfr_fmma (v, x, mpc_imagref (w), y, mpc_realref (w), MPFR_RNDN);
+      mpfr_swap (x, u);
+      mpfr_swap (y, v);
+      e = prec - mpc_ceil_log2 ((mpfr_prec_t) k) - 2;
+
+      if (n % 4 == 0)
+         /* z_(q*n/4+k) = i^q z_k and z_(q*n/4+n/4-k) = i^q i conj(z_k) */
+         for (q = 0; q < 4; q++) {
+            table_rotate (rop [q * q4 + k], n, q * q4 + k, q, x, y, e,
+                          inex, &inexact, rnd);
+            if (q4 - k != k)
+               table_rotate (rop [q * q4 + q4 - k], n, q * q4 + q4 - k, q,
+                             y, x, e, inex, &inexact, rnd);
+         }
+      else {
+         /* z_(n-k) = conj(z_k), and for even n, z_(n/2-k) = -conj(z_k)
+            and z_(n/2+k) = -z_k */
+         table_set (rop [k], n, k, x, 0, y, 0, e, inex, &inexact, rnd);
+         table_set (rop [n - k], n, n - k, x, 0, y, 1, e, inex, &inexact,
+                    rnd);
+         if (n % 2 == 0) {
+            table_set (rop [h - k], n, h - k, x, 1, y, 0, e, inex,
+                       &inexact, rnd);
+            table_set (rop [h + k], n, h + k, x, 1, y, 1, e, inex,
+                       &inexact, rnd);
+         }
+      }
+   }
+   mpc_clear (w);
+   mpfr_clear (x);
+   mpfr_clear (y);
+   mpfr_clear (u);
+   mpfr_clear (v);
+
+   return inexact;
+}
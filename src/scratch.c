@@ -0,0 +1,120 @@
+/* mpc_scratch_init, mpc_scratch_clear, mpc_scratch_attach --
+   Temporary variables kept allocated between function calls.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdio.h> /* for MPC_ASSERT */
+#include "mpc-impl.h"
+
+/* The scratch context attached to the current thread, or NULL; without
+   thread local storage, it would be shared by all threads, so that it
+   always remains NULL. */
+static MPC_THREAD_ATTR mpc_scratch_ptr mpc_scratch_current = NULL;
+
+void
+mpc_scratch_init (mpc_scratch_ptr s)
+{
+   int i;
+
+   for (i = 0; i < __MPC_SCRATCH_SIZE; i++)
+      mpfr_init2 (&(s->tmp [i]), MPFR_PREC_MIN);
+   s->used = 0;
+}
+
+void
+mpc_scratch_clear (mpc_scratch_ptr s)
+{
+   int i;
+
+   MPC_ASSERT (s->used == 0 && s != mpc_scratch_current);
+   for (i = 0; i < __MPC_SCRATCH_SIZE; i++)
+      mpfr_clear (&(s->tmp [i]));
+}
+
+mpc_scratch_ptr
+mpc_scratch_attach (mpc_scratch_ptr s)
+{
+   mpc_scratch_ptr old = mpc_scratch_current;
+
+   MPC_ASSERT (old == NULL || old->used == 0);
+#ifdef HAVE_THREAD_LOCAL
+   mpc_scratch_current = s;
+#else
+   (void) s;
+#endif
+   return old;
+}
+
+/* The following functions replace mpfr_init2 and mpfr_clear resp.
+   mpc_init2 and mpc_clear for temporary variables of the library.
+   If a scratch context is attached to the current thread, the variables
+   are lent out of it and returned to it, keeping their memory, which
+   mpfr_set_prec never shrinks; this avoids the repeated allocations and
+   reallocations of the same temporaries in Ziv loops.
+   The variables must be cleared in the reverse order of their
+   initialisation; beyond __MPC_SCRATCH_SIZE variables, they are
+   allocated normally. */
+
+void
+mpc_tmp_fr_init2 (mpfr_ptr x, mpfr_prec_t prec)
+{
+   mpc_scratch_ptr s = mpc_scratch_current;
+
+   if (s == NULL)
+      mpfr_init2 (x, prec);
+   else {
+      if (s->used < __MPC_SCRATCH_SIZE) {
+         x [0] = s->tmp [s->used];
+         mpfr_set_prec (x, prec);
+      }
+      else
+         mpfr_init2 (x, prec);
+      s->used++;
+   }
+}
+
+void
+mpc_tmp_fr_clear (mpfr_ptr x)
+{
+   mpc_scratch_ptr s = mpc_scratch_current;
+
+   if (s == NULL)
+      mpfr_clear (x);
+   else {
+      s->used--;
+      if (s->used < __MPC_SCRATCH_SIZE)
+         s->tmp [s->used] = x [0];
+      else
+         mpfr_clear (x);
+   }
+}
+
+void
+mpc_tmp_init2 (mpc_ptr z, mpfr_prec_t prec)
+{
+   mpc_tmp_fr_init2 (mpc_realref (z), prec);
+   mpc_tmp_fr_init2 (mpc_imagref (z), prec);
+}
+
+void
+mpc_tmp_clear (mpc_ptr z)
+{
+   mpc_tmp_fr_clear (mpc_imagref (z));
+   mpc_tmp_fr_clear (mpc_realref (z));
+}
@@ -0,0 +1,104 @@
+/* mpc_set_polar -- Set a complex number from its modulus and argument.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+int
+mpc_set_polar (mpc_ptr rop, mpfr_srcptr r, mpfr_srcptr theta, mpc_rnd_t rnd)
+{
+   mpfr_t s, c, rr, tt;
+   mpfr_prec_t prec;
+   int inex, inex_re, inex_im;
+   mpfr_exp_t saved_emin, saved_emax;
+
+   if (r == mpc_realref (rop) || r == mpc_imagref (rop)
+       || theta == mpc_realref (rop) || theta == mpc_imagref (rop)) {
+      mpfr_init2 (rr, mpfr_get_prec (r));
+      mpfr_init2 (tt, mpfr_get_prec (theta));
+      mpfr_set (rr, r, MPFR_RNDN);
+      mpfr_set (tt, theta, MPFR_RNDN);
+      inex = mpc_set_polar (rop, rr, tt, rnd);
+      mpfr_clear (rr);
+      mpfr_clear (tt);
+      return inex;
+   }
+
+   if (mpfr_zero_p (theta)) {
+      /* r * exp (+-i*0) = r +- i*0, also for infinite r */
+      mpfr_set_zero (mpc_imagref (rop),
+                     MPFR_SIGN (r) * MPFR_SIGN (theta) > 0 ? +1 : -1);
+      inex_re = mpfr_set (mpc_realref (rop), r, MPC_RND_RE (rnd));
+      return MPC_INEX (inex_re, 0);
+   }
+
+   if (!mpfr_number_p (r) || mpfr_zero_p (r) || !mpfr_number_p (theta)) {
+      /* for finite theta != 0, sin (theta) and cos (theta) are non-zero,
+         so that only their signs matter; otherwise they are NaN */
+      mpfr_init2 (s, 2);
+      mpfr_init2 (c, 2);
+      mpfr_sin_cos (s, c, theta, MPFR_RNDN);
+      mpfr_mul (mpc_realref (rop), r, c, MPFR_RNDN);
+      mpfr_mul (mpc_imagref (rop), r, s, MPFR_RNDN);
+      mpfr_clear (s);
+      mpfr_clear (c);
+      return MPC_INEX (0, 0);
+   }
+
+   saved_emin = mpfr_get_emin ();
+   saved_emax = mpfr_get_emax ();
+   mpfr_set_emin (mpfr_get_emin_min ());
+   mpfr_set_emax (mpfr_get_emax_max ());
+
+   /* Let c = o(cos (theta)) and u = o(r*c), both rounded to nearest with
+      precision prec; then u = r cos (theta) (1 + t)^2 with |t| <= 2^(-prec),
+      so that the error on u is at most
+      |u| (2^(1-prec) + 2^(-2prec)) (1 + 2^(-prec))^2 < 2^(Exp (u) + 2 - prec),
+      and similarly for the imaginary part. For theta != 0, both parts are
+      irrational, so that the loop terminates. */
+   prec = MPC_MAX_PREC (rop);
+   mpc_tmp_fr_init2 (s, prec);
+   mpc_tmp_fr_init2 (c, prec);
+   do {
+      prec += mpc_ceil_log2 (prec) + 5;
+      mpfr_set_prec (s, prec);
+      mpfr_set_prec (c, prec);
+      mpfr_sin_cos (s, c, theta, MPFR_RNDN);
+      mpfr_mul (c, c, r, MPFR_RNDN);
+      mpfr_mul (s, s, r, MPFR_RNDN);
+   }
+   while (   !mpfr_can_round (c, prec - 2, MPFR_RNDN, MPFR_RNDZ,
+                MPC_PREC_RE (rop) + (MPC_RND_RE (rnd) == MPFR_RNDN))
+          || !mpfr_can_round (s, prec - 2, MPFR_RNDN, MPFR_RNDZ,
+                MPC_PREC_IM (rop) + (MPC_RND_IM (rnd) == MPFR_RNDN)));
+
+   inex_re = mpfr_set (mpc_realref (rop), c, MPC_RND_RE (rnd));
+   inex_im = mpfr_set (mpc_imagref (rop), s, MPC_RND_IM (rnd));
+
+   mpc_tmp_fr_clear (c);
+   mpc_tmp_fr_clear (s);
+
+   /* restore the exponent range, and check the range of results */
+   mpfr_set_emin (saved_emin);
+   mpfr_set_emax (saved_emax);
+   inex_re = mpfr_check_range (mpc_realref (rop), inex_re, MPC_RND_RE (rnd));
+   inex_im = mpfr_check_range (mpc_imagref (rop), inex_im, MPC_RND_IM (rnd));
+
+   return MPC_INEX (inex_re, inex_im);
+}
@@ -1,6 +1,6 @@
 /* mpc_sin_cos -- combined sine and cosine of a complex number.
 
-Copyright (C) 2010, 2011, 2012, 2020, 2024 INRIA
+Copyright (C) 2010, 2011, 2012, 2020, 2024, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -338,156 +338,151 @@ mpc_sin_cos (mpc_ptr rop_sin, mpc_ptr rop_cos, mpc_srcptr op,
          r = sin(a)*cosh(b)*(1+t)^3 with |t| <= 2^(-w),
          thus for w >= 2, r = sin(a)*cosh(b)*(1+4*t) with |t| <= 2^(-w),
          thus the relative error is bounded by 4*2^(-w) <= 4*ulp(r).
+         This remains true if sin(a) and cosh(b) are computed with a larger
+         precision than w. So each of the four parts of the results has its
+         own working precision, which is increased only when this part
+         cannot be rounded, and sin(a), cos(a), sinh(b) and cosh(b) are
+         kept at the largest working precision reached so far; they are
+         recomputed only when a part needs a larger precision.
+         If a is large, sin(a) and cos(a) are computed by mpc_sin_cos_fr
+         with a relative error of at most 2^(2-w) each, and the error on r
+         is then at most 7 ulps.
       */
-      mpfr_t s, c, sh, ch, sch, csh;
-      mpfr_prec_t prec;
-      int ok;
-      int inex_re, inex_im, inex_sin, inex_cos, loop = 0;
+      mpfr_t s, c, sh, ch, r[4];
+      mpfr_ptr dest[4];
+      mpfr_prec_t prec, prec_sin, ps = 0, psh = 0, p[4];
+      mpfr_rnd_t rnd[4];
+      int pending[4], loop[4], inex[4], pending_any, k, reduced = 0;
+      int inex_sin, inex_cos, iter = 0;
       mpfr_exp_t saved_emin, saved_emax;
 
+      if (mpc_sin_cos_dd (rop_sin, rop_cos, op, rnd_sin, rnd_cos, &inex_sin))
+         return inex_sin;
+
       saved_emin = mpfr_get_emin ();
       saved_emax = mpfr_get_emax ();
       mpfr_set_emin (mpfr_get_emin_min ());
       mpfr_set_emax (mpfr_get_emax_max ());
 
-      prec = 2;
+      prec_sin = 2;
       if (rop_sin != NULL)
         {
           mp_prec_t er, ei;
-          prec = MPC_MAX (prec, MPC_MAX_PREC (rop_sin));
           /* since the Taylor expansion of sin(x) at x=0 is x - x^3/6 + O(x^5),
              if x <= 2^(-p), then the second term/x is about 2^(-2p)/6, thus we
              need at least 2p+3 bits of precision. This is true only when x is
              exactly representable in the target precision. */
-          if (MPC_MAX_PREC (op) <= prec)
+          if (MPC_MAX_PREC (op) <= MPC_MAX (prec_sin, MPC_MAX_PREC (rop_sin)))
             {
               er = mpfr_get_exp (mpc_realref (op));
               ei = mpfr_get_exp (mpc_imagref (op));
               /* consider the maximal exponent only */
               er = (er < ei) ? ei : er;
               if (er < 0)
-                if (prec < 2 * (mp_prec_t) (-er) + 3)
-                  prec = 2 * (mp_prec_t) (-er) + 3;
+                if (prec_sin < 2 * (mp_prec_t) (-er) + 3)
+                  prec_sin = 2 * (mp_prec_t) (-er) + 3;
             }
         }
-      if (rop_cos != NULL)
-         prec = MPC_MAX (prec, MPC_MAX_PREC (rop_cos));
+
+      /* the parts are numbered Re(sin(op)), Im(sin(op)), Re(cos(op)),
+         Im(cos(op)); a part is pending as long as it cannot be rounded */
+      dest[0] = (rop_sin != NULL) ? mpc_realref (rop_sin) : NULL;
+      dest[1] = (rop_sin != NULL) ? mpc_imagref (rop_sin) : NULL;
+      dest[2] = (rop_cos != NULL) ? mpc_realref (rop_cos) : NULL;
+      dest[3] = (rop_cos != NULL) ? mpc_imagref (rop_cos) : NULL;
+      rnd[0] = MPC_RND_RE (rnd_sin);
+      rnd[1] = MPC_RND_IM (rnd_sin);
+      rnd[2] = MPC_RND_RE (rnd_cos);
+      rnd[3] = MPC_RND_IM (rnd_cos);
+      for (k = 0; k < 4; k++) {
+         pending[k] = (dest[k] != NULL);
+         loop[k] = 1;
+         if (pending[k]) {
+            p[k] = mpfr_get_prec (dest[k]);
+            if (k < 2)
+               p[k] = MPC_MAX (p[k], prec_sin);
+            p[k] += mpc_ceil_log2 (p[k]) + 5;
+            mpfr_init2 (r[k], p[k]);
+         }
+      }
 
       mpfr_init2 (s, 2);
       mpfr_init2 (c, 2);
       mpfr_init2 (sh, 2);
       mpfr_init2 (ch, 2);
-      mpfr_init2 (sch, 2);
-      mpfr_init2 (csh, 2);
 
       do {
-         MPC_LOOP_NEXT(loop, op, rop_sin); // FIXME: take into account rop_cos too
-         prec += (loop <= 2) ? mpc_ceil_log2 (prec) + 5 : prec / 2;
-
-         mpfr_set_prec (s, prec);
-         mpfr_set_prec (c, prec);
-         mpfr_set_prec (sh, prec);
-         mpfr_set_prec (ch, prec);
-         mpfr_set_prec (sch, prec);
-         mpfr_set_prec (csh, prec);
-
-         mpfr_sin_cos (s, c, mpc_realref(op), MPFR_RNDN);
-         mpfr_sinh_cosh (sh, ch, mpc_imagref(op), MPFR_RNDN);
-
-         ok = 1;
-
-         if (rop_sin != NULL) {
-            /* real part of sine */
-            mpfr_mul (sch, s, ch, MPFR_RNDN);
-            ok = (!mpfr_number_p (sch))
-                  || mpfr_can_round (sch, prec - 2, MPFR_RNDN, MPFR_RNDZ,
-                        MPC_PREC_RE (rop_sin)
-                        + (MPC_RND_RE (rnd_sin) == MPFR_RNDN));
-
-            if (ok) {
-               /* imaginary part of sine */
-               mpfr_mul (csh, c, sh, MPFR_RNDN);
-               ok = (!mpfr_number_p (csh))
-                     || mpfr_can_round (csh, prec - 2, MPFR_RNDN, MPFR_RNDZ,
-                           MPC_PREC_IM (rop_sin)
-                           + (MPC_RND_IM (rnd_sin) == MPFR_RNDN));
-            }
+         MPC_LOOP_NEXT (iter, op, rop_sin != NULL ? rop_sin : rop_cos);
+
+         /* bring sin(a), cos(a), sinh(b), cosh(b) to the largest working
+            precision of the pending parts */
+         prec = 0;
+         for (k = 0; k < 4; k++)
+            if (pending[k])
+               prec = MPC_MAX (prec, p[k]);
+         if (ps < prec) {
+            ps = prec;
+            mpfr_set_prec (s, ps);
+            mpfr_set_prec (c, ps);
+            reduced = mpc_sin_cos_fr (s, c, mpc_realref (op));
+         }
+         if (psh < prec) {
+            psh = prec;
+            mpfr_set_prec (sh, psh);
+            mpfr_set_prec (ch, psh);
+            mpfr_sinh_cosh (sh, ch, mpc_imagref (op), MPFR_RNDN);
          }
 
-         if (rop_cos != NULL && ok) {
-            /* real part of cosine */
-            mpfr_mul (c, c, ch, MPFR_RNDN);
-            ok = (!mpfr_number_p (c))
-                  || mpfr_can_round (c, prec - 2, MPFR_RNDN, MPFR_RNDZ,
-                        MPC_PREC_RE (rop_cos)
-                        + (MPC_RND_RE (rnd_cos) == MPFR_RNDN));
-
-            if (ok) {
-               /* imaginary part of cosine */
-               mpfr_mul (s, s, sh, MPFR_RNDN);
-               mpfr_neg (s, s, MPFR_RNDN);
-               ok = (!mpfr_number_p (s))
-                     || mpfr_can_round (s, prec - 2, MPFR_RNDN, MPFR_RNDZ,
-                           MPC_PREC_IM (rop_cos)
-                           + (MPC_RND_IM (rnd_cos) == MPFR_RNDN));
+         pending_any = 0;
+         for (k = 0; k < 4; k++) {
+            if (!pending[k])
+               continue;
+            mpfr_set_prec (r[k], p[k]);
+            if (k == 0)
+               mpfr_mul (r[k], s, ch, MPFR_RNDN);
+            else if (k == 1)
+               mpfr_mul (r[k], c, sh, MPFR_RNDN);
+            else if (k == 2)
+               mpfr_mul (r[k], c, ch, MPFR_RNDN);
+            else {
+               mpfr_mul (r[k], s, sh, MPFR_RNDN);
+               mpfr_neg (r[k], r[k], MPFR_RNDN);
+            }
+            if (!mpfr_number_p (r[k])
+                || mpfr_can_round (r[k], p[k] - 2 - reduced,
+                                   MPFR_RNDN, MPFR_RNDZ,
+                                   mpfr_get_prec (dest[k])
+                                   + (rnd[k] == MPFR_RNDN)))
+               pending[k] = 0;
+            else {
+               loop[k]++;
+               p[k] += (loop[k] <= 2) ? mpc_ceil_log2 (p[k]) + 5 : p[k] / 2;
+               pending_any = 1;
             }
          }
-      } while (ok == 0);
-
-      if (rop_sin != NULL) {
-         inex_re = mpfr_set (mpc_realref (rop_sin), sch, MPC_RND_RE (rnd_sin));
-         if (mpfr_inf_p (sch))
-           inex_re = mpc_fix_inf (mpc_realref (rop_sin), MPC_RND_RE (rnd_sin));
-         inex_im = mpfr_set (mpc_imagref (rop_sin), csh, MPC_RND_IM (rnd_sin));
-         if (mpfr_inf_p (csh))
-           inex_im = mpc_fix_inf (mpc_imagref (rop_sin), MPC_RND_IM (rnd_sin));
-         inex_sin = MPC_INEX (inex_re, inex_im);
-      }
-      else
-         inex_sin = MPC_INEX (0,0); /* return exact if not computed */
-
-      if (rop_cos != NULL) {
-         inex_re = mpfr_set (mpc_realref (rop_cos), c, MPC_RND_RE (rnd_cos));
-         if (mpfr_inf_p (c))
-           inex_re = mpc_fix_inf (mpc_realref (rop_cos), MPC_RND_RE (rnd_cos));
-         inex_im = mpfr_set (mpc_imagref (rop_cos), s, MPC_RND_IM (rnd_cos));
-         if (mpfr_inf_p (s))
-           inex_im = mpc_fix_inf (mpc_imagref (rop_cos), MPC_RND_IM (rnd_cos));
-         inex_cos = MPC_INEX (inex_re, inex_im);
-      }
-      else
-         inex_cos = MPC_INEX (0,0); /* return exact if not computed */
+      } while (pending_any);
 
       mpfr_clear (s);
       mpfr_clear (c);
       mpfr_clear (sh);
       mpfr_clear (ch);
-      mpfr_clear (sch);
-      mpfr_clear (csh);
+
+      for (k = 0; k < 4; k++)
+         if (dest[k] != NULL) {
+            inex[k] = mpfr_set (dest[k], r[k], rnd[k]);
+            if (mpfr_inf_p (r[k]))
+               inex[k] = mpc_fix_inf (dest[k], rnd[k]);
+            mpfr_clear (r[k]);
+         }
 
       /* restore the exponent range, and check the range of results */
       mpfr_set_emin (saved_emin);
       mpfr_set_emax (saved_emax);
-      if (rop_sin != NULL)
-        {
-          inex_re = mpfr_check_range (mpc_realref (rop_sin),
-                                      MPC_INEX_RE (inex_sin),
-                                      MPC_RND_RE (rnd_sin));
-          inex_im = mpfr_check_range (mpc_imagref (rop_sin),
-                                      MPC_INEX_IM (inex_sin),
-                                      MPC_RND_IM (rnd_sin));
-          inex_sin = MPC_INEX (inex_re, inex_im);
-        }
-      if (rop_cos != NULL)
-        {
-          inex_re = mpfr_check_range (mpc_realref (rop_cos),
-                                      MPC_INEX_RE (inex_cos),
-                                      MPC_RND_RE (rnd_cos));
-          inex_im = mpfr_check_range (mpc_imagref (rop_cos),
-                                      MPC_INEX_IM (inex_cos),
-                                      MPC_RND_IM (rnd_cos));
-          inex_cos = MPC_INEX (inex_re, inex_im);
-        }
+      for (k = 0; k < 4; k++)
+         inex[k] = (dest[k] == NULL) ? 0 /* return exact if not computed */
+                   : mpfr_check_range (dest[k], inex[k], rnd[k]);
+      inex_sin = MPC_INEX (inex[0], inex[1]);
+      inex_cos = MPC_INEX (inex[2], inex[3]);
 
       return (MPC_INEX12 (inex_sin, inex_cos));
    }
@@ -1,6 +1,6 @@
 /* mpc_sqr -- Square a complex number.
 
-Copyright (C) 2002, 2005, 2008, 2009, 2010, 2011, 2012 INRIA
+Copyright (C) 2002, 2005, 2008, 2009, 2010, 2011, 2012, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -225,6 +225,9 @@ mpc_sqr (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
       return MPC_INEX(inex_re, inex_im);
    }
 
+   if (mpc_sqr_limbs (rop, op, rnd, &inexact))
+      return inexact;
+
    if (rop == op)
    {
       mpfr_init2 (x, MPC_PREC_RE (op));
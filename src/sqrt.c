@@ -1,6 +1,6 @@
 /* mpc_sqrt -- Take the square root of a complex number.
 
-Copyright (C) 2002, 2008, 2009, 2010, 2011, 2012, 2020, 2024 INRIA
+Copyright (C) 2002, 2008, 2009, 2010, 2011, 2012, 2020, 2024, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -167,8 +167,8 @@ mpc_sqrt (mpc_ptr a, mpc_srcptr b, mpc_rnd_t rnd)
 
   prec = MPC_MAX_PREC(a);
 
-  mpfr_init (w);
-  mpfr_init (t);
+  mpc_tmp_fr_init2 (w, 2);
+  mpc_tmp_fr_init2 (t, 2);
 
    if (re_cmp > 0) {
       rnd_w = MPC_RND_RE (rnd);
@@ -366,8 +366,8 @@ mpc_sqrt (mpc_ptr a, mpc_srcptr b, mpc_rnd_t rnd)
       }
    }
 
-  mpfr_clear (w);
-  mpfr_clear (t);
+  mpc_tmp_fr_clear (t);
+  mpc_tmp_fr_clear (w);
 
   /* restore the exponent range, and check the range of results */
   mpfr_set_emin (saved_emin);
@@ -1,6 +1,6 @@
 /* mpc_sum -- Add an array of complex numbers.
 
-Copyright (C) 2018 INRIA
+Copyright (C) 2018, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -18,32 +18,80 @@ You should have received a copy of the GNU Lesser General Public License
 along with this program. If not, see http://www.gnu.org/licenses/ .
 */
 
-#include <stdio.h> /* for MPC_ASSERT */
 #include "mpc-impl.h"
 
-int
-mpc_sum (mpc_ptr sum, const mpc_ptr *z, unsigned long n, mpc_rnd_t rnd)
+/* The real and imaginary parts of a sum accumulator are exact sums, so
+   that adding a term costs one exact addition per part, independently of
+   the number of terms already added, and the correctly rounded value may
+   be obtained at any time. */
+
+void
+mpc_sumacc_init (mpc_sumacc_ptr acc)
+{
+  mpc_fsum_init (&acc->re);
+  mpc_fsum_init (&acc->im);
+}
+
+void
+mpc_sumacc_clear (mpc_sumacc_ptr acc)
+{
+  mpc_fsum_clear (&acc->re);
+  mpc_fsum_clear (&acc->im);
+}
+
+/* acc <- acc + z[0] + ... + z[n-1] */
+void
+mpc_sumacc_add_vec (mpc_sumacc_ptr acc, const mpc_ptr *z, unsigned long n)
 {
-  int inex_re, inex_im;
-  mpfr_ptr *t;
   unsigned long i;
 
-  /* avoid a compiler warning when n=0 */
-  if (n == 0)
+  for (i = 0; i < n; i++)
     {
-      mpc_set_ui_ui (sum, 0, 0, rnd);
-      return MPC_INEX(0, 0);
+      mpc_fsum_add (&acc->re, mpc_realref (z[i]));
+      mpc_fsum_add (&acc->im, mpc_imagref (z[i]));
     }
+}
 
-  t = (mpfr_ptr *) malloc (n * sizeof(mpfr_t));
-  MPC_ASSERT(t != NULL);
-  for (i = 0; i < n; i++)
-    t[i] = mpc_realref (z[i]);
-  inex_re = mpfr_sum (mpc_realref (sum), t, n, MPC_RND_RE (rnd));
-  for (i = 0; i < n; i++)
-    t[i] = mpc_imagref (z[i]);
-  inex_im = mpfr_sum (mpc_imagref (sum), t, n, MPC_RND_IM (rnd));
-  free (t);
+/* acc <- acc + z */
+void
+mpc_sumacc_add (mpc_sumacc_ptr acc, mpc_srcptr z)
+{
+  mpc_fsum_add (&acc->re, mpc_realref (z));
+  mpc_fsum_add (&acc->im, mpc_imagref (z));
+}
+
+/* acc <- acc + acc2, where acc2 is not modified; the result is the same
+   as if all terms of acc2 had been added to acc, so that partial sums
+   computed independently may be combined */
+void
+mpc_sumacc_merge (mpc_sumacc_ptr acc, mpc_sumacc_srcptr acc2)
+{
+  mpc_fsum_merge (&acc->re, &acc2->re);
+  mpc_fsum_merge (&acc->im, &acc2->im);
+}
+
+/* rop <- acc, which is not modified, so that more terms may be added */
+int
+mpc_sumacc_get (mpc_ptr rop, mpc_sumacc_srcptr acc, mpc_rnd_t rnd)
+{
+  int inex_re, inex_im;
+
+  inex_re = mpc_fsum_get (mpc_realref (rop), &acc->re, MPC_RND_RE (rnd));
+  inex_im = mpc_fsum_get (mpc_imagref (rop), &acc->im, MPC_RND_IM (rnd));
 
   return MPC_INEX(inex_re, inex_im);
 }
+
+int
+mpc_sum (mpc_ptr sum, const mpc_ptr *z, unsigned long n, mpc_rnd_t rnd)
+{
+  mpc_sumacc_t acc;
+  int inex;
+
+  mpc_sumacc_init (acc);
+  mpc_sumacc_add_vec (acc, z, n);
+  inex = mpc_sumacc_get (sum, acc, rnd);
+  mpc_sumacc_clear (acc);
+
+  return inex;
+}
@@ -1,6 +1,6 @@
 /* mpc_tan -- tangent of a complex number.
 
-Copyright (C) 2008, 2009, 2010, 2011, 2012, 2013, 2015, 2020, 2022, 2024 INRIA
+Copyright (C) 2008, 2009, 2010, 2011, 2012, 2013, 2015, 2020, 2022, 2024, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -18,8 +18,6 @@ You should have received a copy of the GNU Lesser General Public License
 along with this program. If not, see http://www.gnu.org/licenses/ .
 */
 
-#include <stdio.h>    /* for MPC_ASSERT */
-#include <limits.h>
 #include "mpc-impl.h"
 
 /* special case where the imaginary part of tan(op) rounds to -1 or 1:
@@ -118,10 +116,10 @@ tan_re_cmp_zero (mpc_srcptr op, mpfr_exp_t emin, mpfr_ptr xout, mpfr_prec_t px,
 int
 mpc_tan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
 {
-  mpc_t x, y;
-  mpfr_prec_t prec, py;
-  mpfr_exp_t err;
-  int ok;
+  mpc_t x;
+  mpfr_t s, c, sh, ch, d;
+  mpfr_prec_t prec, w, py;
+  int ok, reduced;
   int inex, inex_re, inex_im;
   mpfr_exp_t saved_emin, saved_emax;
 
@@ -247,53 +245,54 @@ mpc_tan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
 
   /* ordinary (non-zero) numbers */
 
-  /* tan(op) = sin(op) / cos(op).
-
-     We use the following algorithm with rounding away from 0 for all
-     operations, and working precision w:
-
-     (1) x = A(sin(op))
-     (2) y = A(cos(op))
-     (3) z = A(x/y)
-
-     the error on Im(z) is at most 81 ulp,
-     the error on Re(z) is at most
-     7 ulp if k < 2,
-     8 ulp if k = 2,
-     else 5+k ulp, where
-     k = Exp(Re(x))+Exp(Re(y))-2min{Exp(Re(y)), Exp(Im(y))}-Exp(Re(x/y))
-     see proof in algorithms.tex.
+  /* Let op = a + i*b. We use the formula
+     tan(op) = [sin(2a) + i*sinh(2b)] / [cos(2a) + cosh(2b)]
+             = [sin(a)*cos(a) + i*sinh(b)*cosh(b)] / [cos(a)^2 + sinh(b)^2]
+     (formula 4.3.57 of Abramowitz and Stegun, with
+     cos(2a) + cosh(2b) = 2*cos(a)^2 + 2*sinh(b)^2),
+     which needs only real functions and a real denominator; in the second
+     form, the denominator is a sum of non-negative terms, so there is no
+     cancellation. All operations round to nearest with working precision
+     w, and the error on each part is at most 2^4 ulp, see algorithms.tex.
+     If a is large, sin(a) and cos(a) are computed by mpc_sin_cos_fr with
+     a relative error of at most 2^(2-w) instead of 2^(-w), which
+     multiplies the bound by at most 4.
   */
 
   prec = MPC_MAX_PREC(rop);
+  w = prec + mpc_ceil_log2 (prec) + 8;
 
-  mpc_init2 (x, 2);
-  mpc_init2 (y, 2);
-
-  err = 7;
+  mpc_tmp_init2 (x, 2);
+  mpc_tmp_fr_init2 (s, 2);
+  mpc_tmp_fr_init2 (c, 2);
+  mpc_tmp_fr_init2 (sh, 2);
+  mpc_tmp_fr_init2 (ch, 2);
+  mpc_tmp_fr_init2 (d, 2);
 
   do
     {
-      mpfr_exp_t k, exr, eyr, eyi, ezr;
-
-      ok = 0;
-
-      /* FIXME: prevent addition overflow */
-      prec += mpc_ceil_log2 (prec) + err;
-      mpc_set_prec (x, prec);
-      mpc_set_prec (y, prec);
-
-      mpc_sin_cos (x, y, op, MPC_RNDAA, MPC_RNDAA);
-
-      if (   mpfr_inf_p (mpc_realref (x)) || mpfr_inf_p (mpc_imagref (x))
-          || mpfr_inf_p (mpc_realref (y)) || mpfr_inf_p (mpc_imagref (y))) {
-         /* If the real or imaginary part of x is infinite, it means that
-            Im(op) was large, in which case the result is
-            sign(tan(Re(op)))*0 + sign(Im(op))*I,
-            where sign(tan(Re(op))) = sign(Re(x))*sign(Re(y)). */
-      large_im:
+      mpc_set_prec (x, w);
+      mpfr_set_prec (s, w);
+      mpfr_set_prec (c, w);
+      mpfr_set_prec (sh, w);
+      mpfr_set_prec (ch, w);
+      mpfr_set_prec (d, w);
+
+      reduced = mpc_sin_cos_fr (s, c, mpc_realref (op));
+      mpfr_sinh_cosh (sh, ch, mpc_imagref (op), MPFR_RNDN);
+      mpfr_sqr (d, c, MPFR_RNDN);
+      mpfr_sqr (mpc_imagref (x), sh, MPFR_RNDN);
+      mpfr_add (d, d, mpc_imagref (x), MPFR_RNDN);
+      mpfr_mul (mpc_realref (x), s, c, MPFR_RNDN);
+      mpfr_mul (mpc_imagref (x), sh, ch, MPFR_RNDN);
+
+      if (mpfr_inf_p (d) || mpfr_inf_p (mpc_imagref (x)))
+        {
+          /* Im(op) is so large that the result is
+             sign(tan(Re(op)))*0 + sign(Im(op))*I, where
+             sign(tan(Re(op))) = sign(sin(Re(op)))*sign(cos(Re(op))). */
           mpfr_set_ui (mpc_realref (rop), 0, MPFR_RNDN);
-          if (mpfr_sgn (mpc_realref (x)) * mpfr_sgn (mpc_realref (y)) < 0)
+          if (mpfr_sgn (s) * mpfr_sgn (c) < 0)
             {
               mpfr_neg (mpc_realref (rop), mpc_realref (rop), MPFR_RNDN);
               inex_re = 1;
@@ -324,61 +323,31 @@ mpc_tan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
           goto end;
         }
 
-      exr = mpfr_get_exp (mpc_realref (x));
-      eyr = mpfr_get_exp (mpc_realref (y));
-      eyi = mpfr_get_exp (mpc_imagref (y));
-
-      /* some parts of the quotient may be exact */
-      inex = mpc_div (x, x, y, MPC_RNDZZ);
-      /* If the imaginary part of x is Inf, we are in the same case as above. */
-      if (mpfr_inf_p (mpc_imagref (x)))
-        goto large_im;
-      /* OP is no pure real nor pure imaginary, so in theory the real and
-         imaginary parts of its tangent cannot be null. However due to
-         rounding errors this might happen. Consider for example
-         tan(1+14*I) = 1.26e-10 + 1.00*I. For small precision sin(op) and
-         cos(op) differ only by a factor I, thus after mpc_div x = I and
-         its real part is zero. */
+      mpfr_div (mpc_realref (x), mpc_realref (x), d, MPFR_RNDN);
+      mpfr_div (mpc_imagref (x), mpc_imagref (x), d, MPFR_RNDN);
+
+      /* OP is no pure real nor pure imaginary, so the real and imaginary
+         parts of its tangent cannot be zero; since we use an extended
+         exponent range, if Re(x) is zero, this means that the real part
+         underflows. */
       if (mpfr_zero_p (mpc_realref (x)))
-        /* since we use an extended exponent range, if real(x) is zero,
-           this means the real part underflows, and we assume we can round */
-        ok = tan_re_cmp_zero (op, saved_emin, mpc_realref (x), MPC_PREC_RE(rop), MPC_RND_RE(rnd));
+        ok = tan_re_cmp_zero (op, saved_emin, mpc_realref (x),
+                              MPC_PREC_RE(rop), MPC_RND_RE(rnd));
       else
-        {
-          if (MPC_INEX_RE (inex))
-            MPFR_ADD_ONE_ULP (mpc_realref (x));
-          MPC_ASSERT (mpfr_zero_p (mpc_realref (x)) == 0);
-          ezr = mpfr_get_exp (mpc_realref (x));
-
-          /* FIXME: compute
-             k = Exp(Re(x))+Exp(Re(y))-2min{Exp(Re(y)), Exp(Im(y))}-Exp(Re(x/y))
-             avoiding overflow */
-          k = exr - ezr + MPC_MAX(-eyr, eyr - 2 * eyi);
-          err = k < 2 ? 7 : (k == 2 ? 8 : (5 + k));
-
-          /* Can the real part be rounded? */
-          ok = (!mpfr_number_p (mpc_realref (x)))
-            || mpfr_can_round (mpc_realref(x), prec - err, MPFR_RNDN, MPFR_RNDZ,
-                               MPC_PREC_RE(rop) + (MPC_RND_RE(rnd) == MPFR_RNDN));
-        }
+        ok = mpfr_can_round (mpc_realref (x), w - 4 - 2 * reduced,
+                             MPFR_RNDN, MPFR_RNDZ,
+                             MPC_PREC_RE(rop) + (MPC_RND_RE(rnd) == MPFR_RNDN));
 
       if (ok)
         {
-          if (MPC_INEX_IM (inex))
-            MPFR_ADD_ONE_ULP (mpc_imagref (x));
-
-          /* Can the imaginary part be rounded? */
-          ok = (!mpfr_number_p (mpc_imagref (x)))
-            || mpfr_can_round (mpc_imagref(x), prec - 6, MPFR_RNDN, MPFR_RNDZ,
-                            MPC_PREC_IM(rop) + (MPC_RND_IM(rnd) == MPFR_RNDN));
-
-          /* Special case when Im(x) = +/- 1:
-             tan z = [sin(2x)+i*sinh(2y)] / [cos(2x) + cosh(2y)]
-             (formula 4.3.57 of Abramowitz and Stegun) thus for y large
-             in absolute value the imaginary part is near -1 or +1.
-             More precisely cos(2x) + cosh(2y) = cosh(2y) + t with |t| <= 1,
+          ok = mpfr_can_round (mpc_imagref (x), w - 4 - 2 * reduced,
+                               MPFR_RNDN, MPFR_RNDZ,
+                               MPC_PREC_IM(rop) + (MPC_RND_IM(rnd) == MPFR_RNDN));
+
+          /* Special case when Im(x) = +/- 1: for y = Im(op), we have
+             cos(2a) + cosh(2y) = cosh(2y) + t with |t| <= 1,
              thus since cosh(2y) >= exp|2y|/2, then the imaginary part is:
-             tanh(2y) * 1/(1+u) where u = |cos(2x)/cosh(2y)| <= 2/exp|2y|
+             tanh(2y) * 1/(1+u) where u = |cos(2a)/cosh(2y)| <= 2/exp|2y|
              thus |im(z) - tanh(2y)| <= 2/exp|2y| * tanh(2y).
              Since |tanh(2y)| = (1-exp(-4|y|))/(1+exp(-4|y|)),
              we have 1-|tanh(2y)| < 2*exp(-4|y|).
@@ -399,15 +368,19 @@ mpc_tan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
         }
 
       if (ok == 0)
-        prec += prec / 2;
+        w += w / 2;
     }
   while (ok == 0);
 
   inex = mpc_set (rop, x, rnd);
 
  end:
-  mpc_clear (x);
-  mpc_clear (y);
+  mpc_tmp_fr_clear (d);
+  mpc_tmp_fr_clear (ch);
+  mpc_tmp_fr_clear (sh);
+  mpc_tmp_fr_clear (c);
+  mpc_tmp_fr_clear (s);
+  mpc_tmp_clear (x);
 
   /* restore the exponent range, and check the range of results */
   mpfr_set_emin (saved_emin);
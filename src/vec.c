@@ -0,0 +1,349 @@
+/* mpc_vec_add, mpc_vec_mul, mpc_vec_sqr, mpc_vec_fma, mpc_vec_div --
+   Elementwise operations on arrays of complex numbers.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* The functions of this file compute rop[i] = f (op1[i], ...) for
+   0 <= i < n and store the ternary value of operation i into inex[i]
+   unless inex is NULL. They return 0 if all results are exact, and a
+   non-zero value otherwise.
+   The common case of arguments with regular real and imaginary parts and
+   moderate exponents is handled inline with temporary variables that are
+   allocated once for the whole array and only ever grow in precision;
+   all other elements are passed on to the function operating on single
+   numbers, which also deals with special values. Both paths return
+   correctly rounded results, so the outcome does not depend on the
+   path taken. */
+
+/* Return non-zero if x and y have regular parts and all products of a
+   part of x and a part of y, as well as sums of two such products, lie
+   in the exponent range [emin, emax]. */
+static int
+vec_products_ok (mpc_srcptr x, mpc_srcptr y, mpfr_exp_t emin,
+   mpfr_exp_t emax)
+{
+   mpfr_exp_t ea, eb, ec, ed;
+
+   if (!mpfr_regular_p (mpc_realref (x)) || !mpfr_regular_p (mpc_imagref (x))
+       || !mpfr_regular_p (mpc_realref (y)) || !mpfr_regular_p (mpc_imagref (y)))
+      return 0;
+
+   ea = mpfr_get_exp (mpc_realref (x));
+   eb = mpfr_get_exp (mpc_imagref (x));
+   ec = mpfr_get_exp (mpc_realref (y));
+   ed = mpfr_get_exp (mpc_imagref (y));
+   /* A product of numbers with exponents e and f has exponent e+f or
+      e+f-1, a sum of two such products has exponent at most e+f+1. */
+   return (MPC_MIN (ea, eb) + MPC_MIN (ec, ed) - 1 >= emin
+           && MPC_MAX (ea, eb) + MPC_MAX (ec, ed) + 1 <= emax);
+}
+
+/* Set z to the exact product of x and y. */
+static void
+vec_mul_exact (mpfr_ptr z, mpfr_srcptr x, mpfr_srcptr y)
+{
+   mpfr_set_prec (z, mpfr_get_prec (x) + mpfr_get_prec (y));
+   mpfr_mul (z, x, y, MPFR_RNDZ); /* exact */
+}
+
+int
+mpc_vec_add (mpc_ptr *rop, const mpc_ptr *op1, const mpc_ptr *op2,
+   unsigned long n, int *inex, mpc_rnd_t rnd)
+{
+   unsigned long i;
+   int inex_re, inex_im, inexact = 0;
+
+   for (i = 0; i < n; i++) {
+      inex_re = mpfr_add (mpc_realref (rop [i]), mpc_realref (op1 [i]),
+                          mpc_realref (op2 [i]), MPC_RND_RE (rnd));
+      inex_im = mpfr_add (mpc_imagref (rop [i]), mpc_imagref (op1 [i]),
+                          mpc_imagref (op2 [i]), MPC_RND_IM (rnd));
+      if (inex != NULL)
+         inex [i] = MPC_INEX (inex_re, inex_im);
+      inexact |= inex_re | inex_im;
+   }
+
+   return inexact;
+}
+
+int
+mpc_vec_mul (mpc_ptr *rop, const mpc_ptr *op1, const mpc_ptr *op2,
+   unsigned long n, int *inex, mpc_rnd_t rnd)
+{
+   /* As mpc_mul, we first try the kernel for one or two limbs; below
+      MUL_KARATSUBA_THRESHOLD, mpc_mul then computes the real and
+      imaginary parts with mpfr_fmms and mpfr_fmma; we do the same, using
+      the temporary variable t in case of overlap. */
+   mpc_t t;
+   unsigned long i;
+   int regular, inex_re, inex_im, inexact = 0;
+
+   mpc_init2 (t, MPFR_PREC_MIN);
+
+   for (i = 0; i < n; i++) {
+      mpc_srcptr x = op1 [i], y = op2 [i];
+      mpc_ptr z = rop [i];
+
+      regular = mpfr_regular_p (mpc_realref (x))
+                && mpfr_regular_p (mpc_imagref (x))
+                && mpfr_regular_p (mpc_realref (y))
+                && mpfr_regular_p (mpc_imagref (y));
+      if (regular && mpc_mul_limbs (z, x, y, rnd, &inex_re))
+         ;
+      else if (regular
+               && MPC_MAX_PREC (z) <= (mpfr_prec_t) MUL_KARATSUBA_THRESHOLD
+                                      * BITS_PER_MP_LIMB) {
+         mpc_ptr r = z;
+         if (z == x || z == y) {
+            r = t;
+            mpfr_set_prec (mpc_realref (t), MPC_PREC_RE (z));
+            mpfr_set_prec (mpc_imagref (t), MPC_PREC_IM (z));
+         }
+         inex_re = mpfr_fmms (mpc_realref (r), mpc_realref (x),
+                              mpc_realref (y), mpc_imagref (x),
+                              mpc_imagref (y), MPC_RND_RE (rnd));
+         inex_im = mpfr_fmma (mpc_imagref (r), mpc_realref (x),
+                              mpc_imagref (y), mpc_imagref (x),
+                              mpc_realref (y), MPC_RND_IM (rnd));
+         if (r != z)
+            mpc_swap (z, t);
+         inex_re = MPC_INEX (inex_re, inex_im);
+      }
+      else
+         inex_re = mpc_mul (z, x, y, rnd);
+      if (inex != NULL)
+         inex [i] = inex_re;
+      inexact |= inex_re;
+   }
+
+   mpc_clear (t);
+
+   return inexact;
+}
+
+int
+mpc_vec_sqr (mpc_ptr *rop, const mpc_ptr *op, unsigned long n, int *inex,
+   mpc_rnd_t rnd)
+{
+   /* Compute Re(x^2) = a^2 - b^2 and Im(x^2) = 2*a*b from the exact
+      squares and product in aa, bb and ab, each with a single rounding.
+      This needs one multiplication more than the Karatsuba squaring of
+      mpc_sqr, but no Ziv loop, and is faster below
+      MUL_KARATSUBA_THRESHOLD. */
+   mpfr_t aa, bb, ab;
+   mpfr_exp_t emin, emax;
+   unsigned long i;
+   int inex_re, inex_im, inexact = 0;
+
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   mpfr_init2 (aa, MPFR_PREC_MIN);
+   mpfr_init2 (bb, MPFR_PREC_MIN);
+   mpfr_init2 (ab, MPFR_PREC_MIN);
+
+   for (i = 0; i < n; i++) {
+      mpc_srcptr x = op [i];
+      mpc_ptr z = rop [i];
+
+      /* as mpc_sqr, try the kernel for one or two limbs first, and
+         leave exact zeroes of the real part to mpc_sqr */
+      if (mpfr_regular_p (mpc_realref (x)) && mpfr_regular_p (mpc_imagref (x))
+          && mpc_sqr_limbs (z, x, rnd, &inex_re))
+         ;
+      else if (MPC_MAX_PREC (x)
+                  <= (mpfr_prec_t) MUL_KARATSUBA_THRESHOLD * BITS_PER_MP_LIMB
+               && vec_products_ok (x, x, emin, emax)
+               && mpfr_cmpabs (mpc_realref (x), mpc_imagref (x)) != 0) {
+         vec_mul_exact (aa, mpc_realref (x), mpc_realref (x));
+         vec_mul_exact (bb, mpc_imagref (x), mpc_imagref (x));
+         vec_mul_exact (ab, mpc_realref (x), mpc_imagref (x));
+         mpfr_mul_2ui (ab, ab, 1, MPFR_RNDN); /* exact */
+         inex_re = mpfr_sub (mpc_realref (z), aa, bb, MPC_RND_RE (rnd));
+         inex_im = mpfr_set (mpc_imagref (z), ab, MPC_RND_IM (rnd));
+         inex_re = MPC_INEX (inex_re, inex_im);
+      }
+      else
+         inex_re = mpc_sqr (z, x, rnd);
+      if (inex != NULL)
+         inex [i] = inex_re;
+      inexact |= inex_re;
+   }
+
+   mpfr_clear (aa);
+   mpfr_clear (bb);
+   mpfr_clear (ab);
+
+   return inexact;
+}
+
+int
+mpc_vec_fma (mpc_ptr *rop, const mpc_ptr *op1, const mpc_ptr *op2,
+   const mpc_ptr *op3, unsigned long n, int *inex, mpc_rnd_t rnd)
+{
+   /* As in mpc_fma_naive, sum the exact products and the third operand
+      with mpfr_sum. */
+   mpfr_t ac, bd, ad, bc;
+   mpfr_ptr sum [3];
+   mpfr_exp_t emin, emax;
+   unsigned long i;
+   int inex_re, inex_im, inexact = 0;
+
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   mpfr_init2 (ac, MPFR_PREC_MIN);
+   mpfr_init2 (bd, MPFR_PREC_MIN);
+   mpfr_init2 (ad, MPFR_PREC_MIN);
+   mpfr_init2 (bc, MPFR_PREC_MIN);
+
+   for (i = 0; i < n; i++) {
+      mpc_srcptr x = op1 [i], y = op2 [i], w = op3 [i];
+      mpc_ptr z = rop [i];
+
+      /* as mpc_fma, try the kernel for one or two limbs first, which
+         needs a finite w */
+      if (mpc_fin_p (w) && mpc_fma_limbs (z, x, y, w, rnd, &inex_re))
+         ;
+      else if (vec_products_ok (x, y, emin, emax)
+               && mpfr_regular_p (mpc_realref (w))
+               && mpfr_regular_p (mpc_imagref (w))) {
+         vec_mul_exact (ac, mpc_realref (x), mpc_realref (y));
+         vec_mul_exact (bd, mpc_imagref (x), mpc_imagref (y));
+         vec_mul_exact (ad, mpc_realref (x), mpc_imagref (y));
+         vec_mul_exact (bc, mpc_imagref (x), mpc_realref (y));
+         mpfr_neg (bd, bd, MPFR_RNDN);
+         /* z may overlap w, whose real part is not used any more once the
+            real part of z is computed */
+         sum [0] = ac;
+         sum [1] = bd;
+         sum [2] = (mpfr_ptr) mpc_realref (w);
+         inex_re = mpfr_sum (mpc_realref (z), sum, 3, MPC_RND_RE (rnd));
+         sum [0] = ad;
+         sum [1] = bc;
+         sum [2] = (mpfr_ptr) mpc_imagref (w);
+         inex_im = mpfr_sum (mpc_imagref (z), sum, 3, MPC_RND_IM (rnd));
+         inex_re = MPC_INEX (inex_re, inex_im);
+      }
+      else
+         inex_re = mpc_fma (z, x, y, w, rnd);
+      if (inex != NULL)
+         inex [i] = inex_re;
+      inexact |= inex_re;
+   }
+
+   mpfr_clear (ac);
+   mpfr_clear (bd);
+   mpfr_clear (ad);
+   mpfr_clear (bc);
+
+   return inexact;
+}
+
+int
+mpc_vec_div (mpc_ptr *rop, const mpc_ptr *op1, const mpc_ptr *op2,
+   unsigned long n, int *inex, mpc_rnd_t rnd)
+{
+   /* For x = a+i*b and y = c+i*d, we have
+         x/y = ((ac+bd) + i*(bc-ad)) / (c^2+d^2).
+      The products are computed exactly, so that each of the numerators
+      and the denominator is affected by only one rounding at the working
+      precision w, and each quotient by three; its relative error is thus
+      bounded by (1+2^(-w))^2/(1-2^(-w)) - 1 < 2^(2-w), and its absolute
+      error by 2^(3-w) |q| < 8 ulp(q). Whenever this does not allow to
+      round correctly, in particular when one of the parts of x/y is
+      exact, the element is passed on to mpc_div. */
+   mpfr_t ac, bd, ad, bc, cc, dd, re, im, norm;
+   mpfr_exp_t emin, emax;
+   mpfr_prec_t prec_re, prec_im, prec;
+   unsigned long i;
+   int inex_re, inex_im, inexact = 0;
+
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   mpfr_init2 (ac, MPFR_PREC_MIN);
+   mpfr_init2 (bd, MPFR_PREC_MIN);
+   mpfr_init2 (ad, MPFR_PREC_MIN);
+   mpfr_init2 (bc, MPFR_PREC_MIN);
+   mpfr_init2 (cc, MPFR_PREC_MIN);
+   mpfr_init2 (dd, MPFR_PREC_MIN);
+   mpfr_init2 (re, MPFR_PREC_MIN);
+   mpfr_init2 (im, MPFR_PREC_MIN);
+   mpfr_init2 (norm, MPFR_PREC_MIN);
+
+   for (i = 0; i < n; i++) {
+      mpc_srcptr x = op1 [i], y = op2 [i];
+      mpc_ptr z = rop [i];
+      int ok = 0;
+
+      prec_re = MPC_PREC_RE (z);
+      prec_im = MPC_PREC_IM (z);
+      if (vec_products_ok (x, y, emin, emax)
+          && vec_products_ok (y, y, emin, emax)) {
+         prec = MPC_MAX (prec_re, prec_im);
+         prec += mpc_ceil_log2 (prec) + 5;
+         mpfr_set_prec (re, prec);
+         mpfr_set_prec (im, prec);
+         mpfr_set_prec (norm, prec);
+         vec_mul_exact (ac, mpc_realref (x), mpc_realref (y));
+         vec_mul_exact (bd, mpc_imagref (x), mpc_imagref (y));
+         vec_mul_exact (ad, mpc_realref (x), mpc_imagref (y));
+         vec_mul_exact (bc, mpc_imagref (x), mpc_realref (y));
+         vec_mul_exact (cc, mpc_realref (y), mpc_realref (y));
+         vec_mul_exact (dd, mpc_imagref (y), mpc_imagref (y));
+         mpfr_add (re, ac, bd, MPFR_RNDN);
+         mpfr_sub (im, bc, ad, MPFR_RNDN);
+         mpfr_add (norm, cc, dd, MPFR_RNDN);
+         if (!mpfr_zero_p (re) && !mpfr_zero_p (im)) {
+            mpfr_div (re, re, norm, MPFR_RNDN);
+            mpfr_div (im, im, norm, MPFR_RNDN);
+            ok = mpfr_regular_p (re) && mpfr_regular_p (im)
+               && mpfr_get_exp (re) > emin && mpfr_get_exp (re) < emax
+               && mpfr_get_exp (im) > emin && mpfr_get_exp (im) < emax
+               && mpfr_can_round (re, prec - 3, MPFR_RNDN, MPFR_RNDZ,
+                     prec_re + (MPC_RND_RE (rnd) == MPFR_RNDN))
+               && mpfr_can_round (im, prec - 3, MPFR_RNDN, MPFR_RNDZ,
+                     prec_im + (MPC_RND_IM (rnd) == MPFR_RNDN));
+         }
+      }
+
+      if (ok) {
+         inex_re = mpfr_set (mpc_realref (z), re, MPC_RND_RE (rnd));
+         inex_im = mpfr_set (mpc_imagref (z), im, MPC_RND_IM (rnd));
+         inex_re = MPC_INEX (inex_re, inex_im);
+      }
+      else
+         inex_re = mpc_div (z, x, y, rnd);
+      if (inex != NULL)
+         inex [i] = inex_re;
+      inexact |= inex_re;
+   }
+
+   mpfr_clear (ac);
+   mpfr_clear (bd);
+   mpfr_clear (ad);
+   mpfr_clear (bc);
+   mpfr_clear (cc);
+   mpfr_clear (dd);
+   mpfr_clear (re);
+   mpfr_clear (im);
+   mpfr_clear (norm);
+
+   return inexact;
+}
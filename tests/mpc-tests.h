@@ -1,6 +1,6 @@
 /* mpc-tests.h -- Tests helper functions.
 
-Copyright (C) 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2020, 2022, 2023, 2024 INRIA
+Copyright (C) 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2020, 2022, 2023, 2024, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -51,6 +51,7 @@ extern "C" {
 __MPC_DECLSPEC int64_t sqrt_int64 (int64_t n);
 __MPC_DECLSPEC int  mpc_mul_naive (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC int  mpc_mul_karatsuba (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_mul_karatsuba3 (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC int  mpc_fma_naive (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
 #if defined (__cplusplus)
 }
@@ -153,6 +154,10 @@ extern int same_mpfr_value (mpfr_ptr got, mpfr_ptr ref, int known_sign);
 extern int same_mpc_value  (mpc_ptr got, mpc_ptr ref,
                             known_signs_t known_signs);
 
+/* reference implementation of mpc_sum with mpfr_sum */
+extern int reference_sum (mpc_ptr res, mpc_ptr *z, unsigned long n,
+                          mpc_rnd_t rnd);
+
 /** READ FILE WITH TEST DATA SET **/
 extern FILE * open_data_file         (const char *file_name);
 extern void   close_data_file        (FILE *fp);
@@ -0,0 +1,49 @@
+/* sum_ref.c -- Reference implementation of complex sums with mpfr_sum.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-tests.h"
+
+/* res <- z[0] + ... + z[n-1], with real and imaginary parts correctly
+   rounded by mpfr_sum; the empty sum is +0 +0*i */
+int
+reference_sum (mpc_ptr res, mpc_ptr *z, unsigned long n, mpc_rnd_t rnd)
+{
+  mpfr_ptr *t;
+  unsigned long i;
+  int inex_re, inex_im;
+
+  if (n == 0)
+    {
+      mpfr_set_zero (mpc_realref (res), +1);
+      mpfr_set_zero (mpc_imagref (res), +1);
+      return MPC_INEX (0, 0);
+    }
+
+  t = (mpfr_ptr *) malloc (n * sizeof (mpfr_ptr));
+  for (i = 0; i < n; i++)
+    t[i] = mpc_realref (z[i]);
+  inex_re = mpfr_sum (mpc_realref (res), t, n, MPC_RND_RE (rnd));
+  for (i = 0; i < n; i++)
+    t[i] = mpc_imagref (z[i]);
+  inex_im = mpfr_sum (mpc_imagref (res), t, n, MPC_RND_IM (rnd));
+  free (t);
+
+  return MPC_INEX (inex_re, inex_im);
+}
@@ -0,0 +1,106 @@
+/* tconst -- test file for the cached constants and mpc_free_cache.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-tests.h"
+
+typedef int (*const_t) (mpfr_ptr, mpfr_rnd_t);
+
+static const mpfr_rnd_t rnds [] =
+   { MPFR_RNDN, MPFR_RNDZ, MPFR_RNDU, MPFR_RNDD, MPFR_RNDA };
+
+static mpfr_t x, ref;
+
+static int
+log10_ref (mpfr_ptr rop, mpfr_rnd_t rnd)
+{
+   return mpfr_log_ui (rop, 10, rnd);
+}
+
+static int
+sqrt3_ref (mpfr_ptr rop, mpfr_rnd_t rnd)
+{
+   return mpfr_sqrt_ui (rop, 3, rnd);
+}
+
+/* Check that the cached constant f agrees with the MPFR function f_ref
+   in precision prec for all rounding modes, including the ternary
+   value. */
+static void
+check_const (const char *name, const_t f, const_t f_ref, mpfr_prec_t prec)
+{
+   int i, inex, inex_ref;
+
+   mpfr_set_prec (x, prec);
+   mpfr_set_prec (ref, prec);
+   for (i = 0; i < 5; i++) {
+      inex_ref = f_ref (ref, rnds [i]);
+      inex = f (x, rnds [i]);
+      if (!mpfr_equal_p (x, ref) || MPC_INEX_POS (inex) != MPC_INEX_POS (inex_ref)) {
+         printf ("mpc_const_%s differs from MPFR in precision %lu\n"
+                 "for rounding mode %s\n", name, (unsigned long) prec,
+                 mpfr_print_rnd_mode (rnds [i]));
+         MPFR_OUT (x);
+         MPFR_OUT (ref);
+         printf ("inex = %i, expected %i\n", inex, inex_ref);
+         exit (1);
+      }
+   }
+}
+
+static void
+check_all (mpfr_prec_t prec)
+{
+   check_const ("pi", mpc_const_pi, mpfr_const_pi, prec);
+   check_const ("log2", mpc_const_log2, mpfr_const_log2, prec);
+   check_const ("log10", mpc_const_log10, log10_ref, prec);
+   check_const ("sqrt3", mpc_const_sqrt3, sqrt3_ref, prec);
+}
+
+int
+main (void)
+{
+   mpfr_prec_t prec;
+
+   test_start ();
+
+   mpfr_init2 (x, 2);
+   mpfr_init2 (ref, 2);
+
+   /* the cache grows with the precision, and smaller precisions are
+      rounded from it */
+   for (prec = MPFR_PREC_MIN; prec <= 300; prec++)
+      check_all (prec);
+   check_all (10000);
+   for (prec = 2; prec <= 1000; prec += 17)
+      check_all (prec);
+   mpc_free_cache ();
+   check_all (1000);
+   check_all (53);
+   mpc_free_cache ();
+   mpc_free_cache ();
+   check_all (17);
+
+   mpfr_clear (x);
+   mpfr_clear (ref);
+
+   test_end ();
+
+   return 0;
+}
@@ -0,0 +1,165 @@
+/* tdd -- test file for the fast paths in double-double arithmetic.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-tests.h"
+
+/* precision of the reference values, from which the correctly rounded
+   results are obtained by a second rounding */
+#define REF_PREC 500
+
+static const mpfr_rnd_t rnds [] =
+   { MPFR_RNDN, MPFR_RNDZ, MPFR_RNDU, MPFR_RNDD, MPFR_RNDA };
+
+static mpc_t x, y, z, z2, ref, ref2, big;
+
+static void
+report (const char *name, mpc_rnd_t rnd, int inex, int inex_ref)
+{
+   printf ("mpc_%s_dd failed for rounding mode (%s, %s)\n", name,
+           mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+           mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+   MPC_OUT (x);
+   MPC_OUT (y);
+   MPC_OUT (z);
+   MPC_OUT (ref);
+   printf ("inex = %i, expected %i\n", inex, inex_ref);
+   exit (1);
+}
+
+/* Compare the result z of a fast path with ternary value inex to the
+   correctly rounded value computed from big. */
+static void
+check_result (const char *name, mpc_rnd_t rnd, int inex)
+{
+   known_signs_t ks = {1, 1};
+   int inex_ref;
+
+   inex_ref = mpc_set (ref, big, rnd);
+   if (!same_mpc_value (z, ref, ks) || inex != inex_ref)
+      report (name, rnd, inex, inex_ref);
+}
+
+static void
+check_all (mpfr_prec_t prec_in, mpfr_prec_t prec_out,
+           mpfr_exp_t emin, mpfr_exp_t emax)
+{
+   int i, j, k, inex, inex_sin, inex_cos;
+   mpc_rnd_t rnd;
+
+   mpc_set_prec (x, prec_in);
+   mpc_set_prec (y, prec_in);
+   mpc_set_prec (z, prec_out);
+   mpc_set_prec (z2, prec_out);
+   mpc_set_prec (ref, prec_out);
+   mpc_set_prec (ref2, prec_out);
+   for (i = 0; i < 20; i++) {
+      test_default_random (x, emin, emax, 128, 0);
+      test_default_random (y, emin, emax, 128, 0);
+      for (j = 0; j < 5; j++)
+         for (k = 0; k < 5; k++) {
+            rnd = MPC_RND (rnds [j], rnds [k]);
+
+            if (mpc_div_dd (z, x, y, rnd, &inex)) {
+               mpc_div (big, x, y, MPC_RNDNN);
+               check_result ("div", rnd, inex);
+            }
+            if (mpc_exp_dd (z, x, rnd, &inex)) {
+               mpc_exp (big, x, MPC_RNDNN);
+               check_result ("exp", rnd, inex);
+            }
+            if (mpc_log_dd (z, x, rnd, &inex)) {
+               mpc_log (big, x, MPC_RNDNN);
+               check_result ("log", rnd, inex);
+            }
+            if (mpc_log_base_dd (z, x, 2, rnd, &inex)) {
+               mpc_log2 (big, x, MPC_RNDNN);
+               check_result ("log_base (2)", rnd, inex);
+            }
+            if (mpc_log_base_dd (z, x, 10, rnd, &inex)) {
+               mpc_log10 (big, x, MPC_RNDNN);
+               check_result ("log_base (10)", rnd, inex);
+            }
+            if (mpc_sin_cos_dd (z, z2, x, rnd, rnd, &inex)) {
+               known_signs_t ks = {1, 1};
+
+               mpc_sin_cos (big, NULL, x, MPC_RNDNN, MPC_RNDNN);
+               inex_sin = mpc_set (ref, big, rnd);
+               mpc_sin_cos (NULL, big, x, MPC_RNDNN, MPC_RNDNN);
+               inex_cos = mpc_set (ref2, big, rnd);
+               if (!same_mpc_value (z, ref, ks)
+                   || !same_mpc_value (z2, ref2, ks)
+                   || inex != MPC_INEX12 (inex_sin, inex_cos)) {
+                  MPC_OUT (z2);
+                  MPC_OUT (ref2);
+                  report ("sin_cos", rnd, inex,
+                          MPC_INEX12 (inex_sin, inex_cos));
+               }
+            }
+         }
+   }
+}
+
+int
+main (void)
+{
+   mpfr_prec_t p;
+   mpfr_exp_t emin, emax;
+
+   test_start ();
+
+   mpc_init2 (x, 2);
+   mpc_init2 (y, 2);
+   mpc_init2 (z, 2);
+   mpc_init2 (z2, 2);
+   mpc_init2 (ref, 2);
+   mpc_init2 (ref2, 2);
+   mpc_init2 (big, REF_PREC);
+
+   for (p = 2; p <= DD_MAX_PREC; p += 13) {
+      check_all (53, p, -5, 5);
+      check_all (106, p, -5, 5);
+      check_all (p, p, -20, 20);
+   }
+   check_all (106, DD_MAX_PREC, -100, 100);
+
+   /* the low parts of arguments with more than 53 bits lie below a
+      reduced exponent range, so that they cannot be split exactly */
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   mpfr_set_emin (-300);
+   mpfr_set_emax (300);
+   for (p = 2; p <= DD_MAX_PREC; p += 13)
+      check_all (97, p, -256, -240);
+   check_all (106, DD_MAX_PREC, -256, -240);
+   mpfr_set_emin (emin);
+   mpfr_set_emax (emax);
+
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (z);
+   mpc_clear (z2);
+   mpc_clear (ref);
+   mpc_clear (ref2);
+   mpc_clear (big);
+
+   test_end ();
+
+   return 0;
+}
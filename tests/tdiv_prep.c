@@ -0,0 +1,183 @@
+/* tdiv_prep -- test file for mpc_div_prepared.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-tests.h"
+
+static const mpfr_rnd_t rnds [] =
+   { MPFR_RNDN, MPFR_RNDZ, MPFR_RNDU, MPFR_RNDD, MPFR_RNDA };
+
+static mpc_t z, w, q, ref;
+
+/* Compare mpc_div_prepared on z and w prepared for precision prec with
+   mpc_div, for all rounding modes, also with the result in a copy of z. */
+static void
+check (mpfr_prec_t prec)
+{
+   known_signs_t ks = {1, 1};
+   mpc_divisor_t d;
+   mpc_rnd_t rnd;
+   mpc_t zz, zref;
+   int i, j, inex, inex_ref;
+
+   mpc_div_prepare (d, w, prec);
+   mpc_init3 (zz, MPC_PREC_RE (z), MPC_PREC_IM (z));
+   mpc_init3 (zref, MPC_PREC_RE (z), MPC_PREC_IM (z));
+   for (i = 0; i < 5; i++)
+      for (j = 0; j < 5; j++) {
+         rnd = MPC_RND (rnds [i], rnds [j]);
+         inex_ref = mpc_div (ref, z, w, rnd);
+         inex = mpc_div_prepared (q, z, d, rnd);
+         if (!same_mpc_value (q, ref, ks) || inex != inex_ref) {
+            printf ("mpc_div_prepared failed for rounding mode (%s, %s)\n",
+                    mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+                    mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+            MPC_OUT (z);
+            MPC_OUT (w);
+            MPC_OUT (q);
+            MPC_OUT (ref);
+            printf ("inex = %i, expected %i\n", inex, inex_ref);
+            exit (1);
+         }
+         inex_ref = mpc_div (zref, z, w, rnd);
+         mpc_set (zz, z, MPC_RNDNN);
+         inex = mpc_div_prepared (zz, zz, d, rnd);
+         if (!same_mpc_value (zz, zref, ks) || inex != inex_ref) {
+            printf ("mpc_div_prepared failed with the result in the "
+                    "dividend\n");
+            MPC_OUT (z);
+            MPC_OUT (w);
+            MPC_OUT (zz);
+            MPC_OUT (zref);
+            printf ("inex = %i, expected %i\n", inex, inex_ref);
+            exit (1);
+         }
+      }
+   mpc_clear (zz);
+   mpc_clear (zref);
+   mpc_divisor_clear (d);
+}
+
+static void
+check_random (mpfr_prec_t prec_in, mpfr_prec_t prec_out, mpfr_exp_t emax)
+{
+   int i;
+
+   mpc_set_prec (z, prec_in);
+   mpc_set_prec (w, prec_in);
+   mpc_set_prec (q, prec_out);
+   mpc_set_prec (ref, prec_out);
+   for (i = 0; i < 20; i++) {
+      test_default_random (z, -emax, emax, 128, 10);
+      test_default_random (w, -emax, emax, 128, 10);
+      if (i % 5 == 1)
+         /* exact quotient */
+         mpc_mul (z, z, w, MPC_RNDNN);
+      check (prec_out);
+      check (prec_out + 100);
+      /* the result precision is larger than the prepared one */
+      check (prec_out > 2 ? prec_out - 1 : prec_out);
+   }
+}
+
+static void
+check_special (void)
+{
+   mpc_set_prec (z, 53);
+   mpc_set_prec (w, 53);
+   mpc_set_prec (q, 53);
+   mpc_set_prec (ref, 53);
+
+   mpc_set_si_si (z, 3, -7, MPC_RNDNN);
+   mpc_set_ui_ui (w, 0, 0, MPC_RNDNN);
+   check (53);
+   mpc_set_si_si (w, 5, 0, MPC_RNDNN);
+   check (53);
+   mpc_set_si_si (w, 0, -5, MPC_RNDNN);
+   check (53);
+   mpfr_set_inf (mpc_realref (w), -1);
+   check (53);
+   mpfr_set_nan (mpc_imagref (w));
+   check (53);
+   mpc_set_si_si (w, 1, 1, MPC_RNDNN);
+   mpfr_set_inf (mpc_imagref (z), +1);
+   check (53);
+   mpfr_set_nan (mpc_realref (z));
+   check (53);
+   mpc_set_si_si (z, 0, 0, MPC_RNDNN);
+   mpc_neg (z, z, MPC_RNDNN);
+   check (53);
+   /* z is a multiple of w, so that the real part of the quotient is an
+      exact zero */
+   mpc_set_si_si (z, -3, 3, MPC_RNDNN);
+   check (53);
+}
+
+static void
+check_range (void)
+{
+   mpfr_exp_t emin, emax;
+
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   mpfr_set_emin (-100);
+   mpfr_set_emax (100);
+   /* quotients close to overflow and underflow */
+   check_random (53, 53, 100);
+   mpc_set_si_si (z, 1, 1, MPC_RNDNN);
+   mpc_mul_2si (z, z, 99, MPC_RNDNN);
+   mpc_set_si_si (w, 1, -3, MPC_RNDNN);
+   mpc_div_2ui (w, w, 5, MPC_RNDNN);
+   check (53);
+   mpc_div_2ui (w, w, 90, MPC_RNDNN);
+   mpc_div_2ui (z, z, 180, MPC_RNDNN);
+   check (53);
+   mpfr_set_emin (emin);
+   mpfr_set_emax (emax);
+}
+
+int
+main (void)
+{
+   mpfr_prec_t p;
+
+   test_start ();
+
+   mpc_init2 (z, 2);
+   mpc_init2 (w, 2);
+   mpc_init2 (q, 2);
+   mpc_init2 (ref, 2);
+
+   check_special ();
+   for (p = 2; p <= 300; p += 37) {
+      check_random (p, p, 10);
+      check_random (53, p, 1000);
+      check_random (2 * p, p, 10);
+   }
+   check_range ();
+
+   mpc_clear (z);
+   mpc_clear (w);
+   mpc_clear (q);
+   mpc_clear (ref);
+
+   test_end ();
+
+   return 0;
+}
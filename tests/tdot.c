@@ -1,6 +1,6 @@
 /* tdot -- test file for mpc_dot.
 
-Copyright (C) 2018, 2020 INRIA
+Copyright (C) 2018, 2020, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -83,13 +83,204 @@ bug20200717 (void)
   mpc_clear (a);
 }
 
+/* reference implementation: res <- x[0]*y[0] + ..., where
+   x[i]*y[i] is split into the exact terms Re(x[i]) * y[i] and
+   i*Im(x[i]) * y[i] */
+static int
+dot_ref (mpc_ptr res, mpc_ptr *x, mpc_ptr *y, unsigned long n,
+         mpc_rnd_t rnd)
+{
+  mpc_t *z;
+  mpc_ptr *t;
+  unsigned long i;
+  int inex;
+
+  z = (mpc_t *) malloc (2 * n * sizeof (mpc_t));
+  t = (mpc_ptr *) malloc (2 * n * sizeof (mpc_ptr));
+  for (i = 0; i < n; i++)
+    {
+      mpc_init3 (z[2*i], MPC_PREC_RE (x[i]) + MPC_PREC_RE (y[i]),
+                 MPC_PREC_RE (x[i]) + MPC_PREC_IM (y[i]));
+      mpfr_mul (mpc_realref (z[2*i]), mpc_realref (x[i]), mpc_realref (y[i]),
+                MPFR_RNDN);
+      mpfr_mul (mpc_imagref (z[2*i]), mpc_realref (x[i]), mpc_imagref (y[i]),
+                MPFR_RNDN);
+      mpc_init3 (z[2*i+1], MPC_PREC_IM (x[i]) + MPC_PREC_IM (y[i]),
+                 MPC_PREC_IM (x[i]) + MPC_PREC_RE (y[i]));
+      mpfr_mul (mpc_realref (z[2*i+1]), mpc_imagref (x[i]),
+                mpc_imagref (y[i]), MPFR_RNDN);
+      mpfr_neg (mpc_realref (z[2*i+1]), mpc_realref (z[2*i+1]), MPFR_RNDN);
+      mpfr_mul (mpc_imagref (z[2*i+1]), mpc_imagref (x[i]),
+                mpc_realref (y[i]), MPFR_RNDN);
+      t[2*i] = z[2*i];
+      t[2*i+1] = z[2*i+1];
+    }
+  inex = reference_sum (res, t, 2 * n, rnd);
+  for (i = 0; i < 2 * n; i++)
+    mpc_clear (z[i]);
+  free (t);
+  free (z);
+
+  return inex;
+}
+
+/* check the streaming interface against dot_ref after each term, for
+   random vectors of length n, which contain special values if special
+   is non-zero */
+#define NMAX 20
+static void
+check_stream (mpfr_prec_t prec, unsigned long n, int special)
+{
+  mpc_t z[2 * NMAX], res, ref;
+  mpc_ptr x[NMAX], y[NMAX];
+  mpc_dot_t d;
+  unsigned long i;
+  int inex, inex_ref;
+  mpc_rnd_t rnd;
+  known_signs_t ks = {1, 1};
+
+  for (i = 0; i < 2 * n; i++)
+    {
+      mpc_init2 (z[i], prec + (mpfr_prec_t) i);
+      test_default_random (z[i], -30, 30, 128, 25);
+      if (special && i % 5 == 2)
+        mpfr_set_zero (mpc_realref (z[i]), (i % 3 == 0) ? +1 : -1);
+      if (special && i % 7 == 3)
+        mpfr_set_zero (mpc_imagref (z[i]), (i % 2 == 0) ? +1 : -1);
+      if (special && i == 2 * n - 1)
+        mpfr_set_inf (mpc_realref (z[i]), (n % 2 == 0) ? +1 : -1);
+      if (special && i == 0 && n % 3 == 0)
+        mpfr_set_nan (mpc_imagref (z[i]));
+    }
+  for (i = 0; i < n; i++)
+    {
+      x[i] = z[i];
+      y[i] = z[n + i];
+    }
+  mpc_init2 (res, prec);
+  mpc_init2 (ref, prec);
+
+  mpc_dot_init (d);
+  for (i = 0; i <= n; i++)
+    {
+      rnd = MPC_RND (i % 5 == 4 ? MPFR_RNDA : (mpfr_rnd_t) (i % 4),
+                     (mpfr_rnd_t) ((i + n) % 4));
+      inex = mpc_dot_get (res, d, rnd);
+      inex_ref = dot_ref (ref, x, y, i, rnd);
+      if (!same_mpc_value (res, ref, ks) || inex != inex_ref)
+        {
+          printf ("mpc_dot_get differs from the reference after %lu "
+                  "terms\nfor rounding mode (%s, %s)\n", i,
+                  mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+                  mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+          MPC_OUT (res);
+          MPC_OUT (ref);
+          printf ("inex = %d, expected %d\n", inex, inex_ref);
+          exit (1);
+        }
+      if (i < n)
+        mpc_dot_add (d, x[i], y[i]);
+    }
+  mpc_dot_clear (d);
+
+  /* one-shot version, with the result in the input x[0] = z[0], which
+     has precision prec */
+  rnd = MPC_RND (MPFR_RNDZ, MPFR_RNDN);
+  inex_ref = dot_ref (ref, x, y, n, rnd);
+  inex = mpc_dot (z[0], x, y, n, rnd);
+  if (!same_mpc_value (z[0], ref, ks) || inex != inex_ref)
+    {
+      printf ("mpc_dot differs from the reference\n");
+      MPC_OUT (z[0]);
+      MPC_OUT (ref);
+      exit (1);
+    }
+
+  for (i = 0; i < 2 * n; i++)
+    mpc_clear (z[i]);
+  mpc_clear (res);
+  mpc_clear (ref);
+}
+
+/* check mpc_dot_get after each term for products in three clusters of
+   exponents around -e, 0 and e */
+static void
+check_far (mpfr_prec_t prec, unsigned long n, mpfr_exp_t e)
+{
+  mpc_t z[2 * NMAX], res, ref;
+  mpc_ptr x[NMAX], y[NMAX];
+  mpc_dot_t d;
+  unsigned long i;
+  int inex, inex_ref;
+  known_signs_t ks = {1, 1};
+
+  for (i = 0; i < 2 * n; i++)
+    {
+      mpc_init2 (z[i], prec + (mpfr_prec_t) (i % 5) * 30);
+      test_default_random (z[i], -10, 10, 128, 0);
+    }
+  for (i = 0; i < n; i++)
+    {
+      mpc_mul_2si (z[i], z[i], ((long) (i % 3) - 1) * e, MPC_RNDNN);
+      x[i] = z[i];
+      y[i] = z[n + i];
+    }
+  mpc_init2 (res, prec);
+  mpc_init2 (ref, prec);
+
+  mpc_dot_init (d);
+  for (i = 0; i < n; i++)
+    {
+      mpc_dot_add (d, x[i], y[i]);
+      inex = mpc_dot_get (res, d, MPC_RNDZN);
+      inex_ref = dot_ref (ref, x, y, i + 1, MPC_RNDZN);
+      if (!same_mpc_value (res, ref, ks) || inex != inex_ref)
+        {
+          printf ("mpc_dot_get differs from the reference after %lu "
+                  "terms with exponents around -%ld, 0 and %ld\n",
+                  i + 1, (long) e, (long) e);
+          MPC_OUT (res);
+          MPC_OUT (ref);
+          printf ("inex = %d, expected %d\n", inex, inex_ref);
+          exit (1);
+        }
+    }
+  mpc_dot_clear (d);
+
+  for (i = 0; i < 2 * n; i++)
+    mpc_clear (z[i]);
+  mpc_clear (res);
+  mpc_clear (ref);
+}
+
 int
 main (void)
 {
+  unsigned long n;
+  mpfr_exp_t emin, emax;
+
   test_start ();
 
   bug20200717 ();
   check_special ();
+  for (n = 1; n <= NMAX; n++)
+    {
+      check_stream (2, n, 0);
+      check_stream (53, n, 0);
+      check_stream (200, n, 0);
+      check_stream (53, n, 1);
+      check_far (53, n, 1l << 29);
+    }
+
+  /* products far apart in the extended exponent range */
+  emin = mpfr_get_emin ();
+  emax = mpfr_get_emax ();
+  mpfr_set_emin (mpfr_get_emin_min ());
+  mpfr_set_emax (mpfr_get_emax_max ());
+  for (n = 1; n <= NMAX; n++)
+    check_far (100, n, mpfr_get_emax_max () / 2);
+  mpfr_set_emin (emin);
+  mpfr_set_emax (emax);
 
   test_end ();
 
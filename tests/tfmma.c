@@ -0,0 +1,146 @@
+/* tfmma -- test file for mpc_fmma and mpc_fmms.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-tests.h"
+
+/* Compare a*b+c*d and a*b-c*d with the results of mpc_fma on the exact
+   value of a*b, computed with a precision large enough for the exponent
+   range [-emax, emax] of the operands. */
+static void
+check_random (mpfr_exp_t emax)
+{
+  known_signs_t ks = {1, 1};
+  mpfr_prec_t prec;
+  mpc_t a, b, c, d, dn, ab, z, ref;
+  int i, rnd_re, rnd_im, inex, inex_ref;
+  mpc_rnd_t rnd;
+
+  mpc_init2 (a, 2);
+  mpc_init2 (b, 2);
+  mpc_init2 (c, 2);
+  mpc_init2 (d, 2);
+  mpc_init2 (dn, 2);
+  mpc_init2 (ab, 2);
+  mpc_init2 (z, 2);
+  mpc_init2 (ref, 2);
+
+  for (prec = 2; prec < 600; prec = (mpfr_prec_t) (prec * 1.3 + 1))
+    for (i = 0; i < 10; i++)
+      {
+        mpc_set_prec (a, prec);
+        mpc_set_prec (b, prec);
+        mpc_set_prec (c, prec);
+        mpc_set_prec (d, prec);
+        mpc_set_prec (dn, prec);
+        mpc_set_prec (ab, 2 * prec + 4 * emax + 8);
+        mpc_set_prec (z, prec);
+        mpc_set_prec (ref, prec);
+        test_default_random (a, -emax, emax, 128, 16);
+        test_default_random (b, -emax, emax, 128, 16);
+        test_default_random (c, -emax, emax, 128, 16);
+        test_default_random (d, -emax, emax, 128, 16);
+        if (i % 3 == 1)
+          {
+            /* provoke a cancellation */
+            mpc_set (c, a, MPC_RNDNN);
+            mpc_neg (d, b, MPC_RNDNN);
+            mpfr_nextabove (mpc_realref (d));
+          }
+        mpc_mul (ab, a, b, MPC_RNDNN); /* exact */
+        mpc_neg (dn, d, MPC_RNDNN);
+        for (rnd_re = 0; rnd_re < 4; rnd_re ++)
+          for (rnd_im = 0; rnd_im < 4; rnd_im ++)
+            {
+              rnd = MPC_RND (rnd_re, rnd_im);
+              inex_ref = mpc_fma (ref, c, d, ab, rnd);
+              inex = mpc_fmma (z, a, b, c, d, rnd);
+              if (!same_mpc_value (z, ref, ks) || inex != inex_ref)
+                {
+                  printf ("mpc_fmma failed for rnd=(%s,%s)\n",
+                          mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+                          mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+                  goto error;
+                }
+              inex_ref = mpc_fma (ref, c, dn, ab, rnd);
+              mpc_set (z, d, MPC_RNDNN);
+              inex = mpc_fmms (z, a, b, c, z, rnd);
+              if (!same_mpc_value (z, ref, ks) || inex != inex_ref)
+                {
+                  printf ("mpc_fmms failed for rnd=(%s,%s)\n",
+                          mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+                          mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+                  goto error;
+                }
+            }
+      }
+
+  mpc_clear (a);
+  mpc_clear (b);
+  mpc_clear (c);
+  mpc_clear (d);
+  mpc_clear (dn);
+  mpc_clear (ab);
+  mpc_clear (z);
+  mpc_clear (ref);
+  return;
+
+ error:
+  MPC_OUT (a);
+  MPC_OUT (b);
+  MPC_OUT (c);
+  MPC_OUT (d);
+  MPC_OUT (z);
+  MPC_OUT (ref);
+  printf ("inex = %i, expected %i\n", inex, inex_ref);
+  exit (1);
+}
+
+#define MPC_FUNCTION_CALL                                               \
+  P[0].mpc_inex = mpc_fmma (P[1].mpc, P[2].mpc, P[3].mpc, P[4].mpc,     \
+                            P[5].mpc, P[6].mpc_rnd)
+#define MPC_FUNCTION_CALL_REUSE_OP1                                     \
+  P[0].mpc_inex = mpc_fmma (P[1].mpc, P[1].mpc, P[3].mpc, P[4].mpc,     \
+                            P[5].mpc, P[6].mpc_rnd)
+#define MPC_FUNCTION_CALL_REUSE_OP2                                     \
+  P[0].mpc_inex = mpc_fmma (P[1].mpc, P[2].mpc, P[1].mpc, P[4].mpc,     \
+                            P[5].mpc, P[6].mpc_rnd)
+#define MPC_FUNCTION_CALL_REUSE_OP3                                     \
+  P[0].mpc_inex = mpc_fmma (P[1].mpc, P[2].mpc, P[3].mpc, P[1].mpc,     \
+                            P[5].mpc, P[6].mpc_rnd)
+
+#include "data_check.tpl"
+#include "tgeneric.tpl"
+
+int
+main (void)
+{
+  test_start ();
+
+  check_random (20);
+  check_random (200);
+
+  data_check_template ("fmma.dsc", "fmma.dat");
+
+  tgeneric_template ("fmma.dsc", 2, 512, 1, 128);
+
+  test_end ();
+
+  return 0;
+}
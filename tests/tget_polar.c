@@ -0,0 +1,157 @@
+/* tget_polar -- test file for mpc_get_polar.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+#include "mpc-tests.h"
+
+/* check mpc_get_polar against mpfr_hypot and mpfr_atan2, that is, against
+   mpc_abs and mpc_arg, for all rounding modes */
+static void
+check_abs_arg (mpc_srcptr z, mpfr_prec_t pr, mpfr_prec_t pt)
+{
+  mpfr_t r, theta, r_ref, theta_ref;
+  mpc_rnd_t rnd;
+  int rnd_re, rnd_im, inex, inex_r, inex_theta;
+
+  mpfr_init2 (r, pr);
+  mpfr_init2 (r_ref, pr);
+  mpfr_init2 (theta, pt);
+  mpfr_init2 (theta_ref, pt);
+  for (rnd_re = 0; rnd_re < 4; rnd_re++)
+    for (rnd_im = 0; rnd_im < 4; rnd_im++)
+      {
+        rnd = MPC_RND (rnd_re, rnd_im);
+        inex = mpc_get_polar (r, theta, z, rnd);
+        inex_r = mpfr_hypot (r_ref, mpc_realref (z), mpc_imagref (z),
+                             MPC_RND_RE (rnd));
+        inex_theta = mpfr_atan2 (theta_ref, mpc_imagref (z), mpc_realref (z),
+                                 MPC_RND_IM (rnd));
+        if (!same_mpfr_value (r, r_ref, 1)
+            || !same_mpfr_value (theta, theta_ref, 1)
+            || inex != MPC_INEX (inex_r, inex_theta))
+          {
+            printf ("Error in mpc_get_polar for z=");
+            mpc_out_str (stdout, 16, 0, z, MPC_RNDNN);
+            printf (" and rnd=%d\n", rnd);
+            printf ("got      r=");
+            mpfr_out_str (stdout, 16, 0, r, MPFR_RNDN);
+            printf (" theta=");
+            mpfr_out_str (stdout, 16, 0, theta, MPFR_RNDN);
+            printf (" inex=%d\nexpected r=", inex);
+            mpfr_out_str (stdout, 16, 0, r_ref, MPFR_RNDN);
+            printf (" theta=");
+            mpfr_out_str (stdout, 16, 0, theta_ref, MPFR_RNDN);
+            printf (" inex=%d\n", MPC_INEX (inex_r, inex_theta));
+            exit (1);
+          }
+      }
+  mpfr_clear (r);
+  mpfr_clear (r_ref);
+  mpfr_clear (theta);
+  mpfr_clear (theta_ref);
+}
+
+static void
+check_random (mpfr_prec_t pmax, int iter)
+{
+  mpc_t z;
+  mpfr_prec_t p;
+  int i;
+
+  mpc_init2 (z, 2);
+  for (p = MPFR_PREC_MIN; p <= pmax; p++)
+    for (i = 0; i < iter; i++)
+      {
+        mpc_set_prec (z, p);
+        test_default_random (z, -300, 300, 128, 16);
+        check_abs_arg (z, p, p);
+        check_abs_arg (z, MPFR_PREC_MIN, 2 * p);
+      }
+  mpc_clear (z);
+}
+
+static void
+set_special (mpfr_ptr x, int k)
+{
+  switch (k)
+    {
+    case 0: mpfr_set_zero (x, +1); break;
+    case 1: mpfr_set_zero (x, -1); break;
+    case 2: mpfr_set_inf (x, +1); break;
+    case 3: mpfr_set_inf (x, -1); break;
+    case 4: mpfr_set_nan (x); break;
+    case 5: mpfr_set_si (x, -3, MPFR_RNDN); break;
+    default: mpfr_set_ui (x, 4, MPFR_RNDN);
+    }
+}
+
+static void
+check_special (void)
+{
+  mpc_t z;
+  int i, j;
+
+  mpc_init2 (z, 53);
+  for (i = 0; i < 7; i++)
+    for (j = 0; j < 7; j++)
+      {
+        set_special (mpc_realref (z), i);
+        set_special (mpc_imagref (z), j);
+        check_abs_arg (z, 53, 53);
+        check_abs_arg (z, 2, 2);
+      }
+  mpc_clear (z);
+}
+
+/* check that the outputs may be the parts of the operand */
+static void
+check_reuse (void)
+{
+  mpc_t z;
+  mpfr_t r, theta;
+
+  mpc_init2 (z, 53);
+  mpfr_init2 (r, 53);
+  mpfr_init2 (theta, 53);
+  mpc_set_si_si (z, -3, 4, MPC_RNDNN);
+  mpc_get_polar (r, theta, z, MPC_RNDNN);
+  mpc_get_polar (mpc_realref (z), mpc_imagref (z), z, MPC_RNDNN);
+  if (!mpfr_equal_p (mpc_realref (z), r)
+      || !mpfr_equal_p (mpc_imagref (z), theta))
+    {
+      printf ("Error in mpc_get_polar when reusing the operand\n");
+      exit (1);
+    }
+  mpc_clear (z);
+  mpfr_clear (r);
+  mpfr_clear (theta);
+}
+
+int
+main (void)
+{
+  test_start ();
+
+  check_special ();
+  check_reuse ();
+  check_random (128, 10);
+
+  test_end ();
+
+  return 0;
+}
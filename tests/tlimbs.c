@@ -0,0 +1,156 @@
+/* tlimbs -- test file for the kernels for operands of one or two limbs.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-tests.h"
+
+static const mpfr_rnd_t rnds [] =
+   { MPFR_RNDN, MPFR_RNDZ, MPFR_RNDU, MPFR_RNDD, MPFR_RNDA };
+
+static mpc_t x, y, c, z, ref;
+static mpfr_t n, nref;
+
+static void
+report (const char *name, mpc_rnd_t rnd, int inex, int inex_ref)
+{
+   printf ("mpc_%s_limbs failed for rounding mode (%s, %s)\n", name,
+           mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+           mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+   MPC_OUT (x);
+   MPC_OUT (y);
+   MPC_OUT (c);
+   MPC_OUT (z);
+   MPC_OUT (ref);
+   MPFR_OUT (n);
+   MPFR_OUT (nref);
+   printf ("inex = %i, expected %i\n", inex, inex_ref);
+   exit (1);
+}
+
+/* Compare the kernels on x, y and c with the generic algorithms. */
+static void
+check (mpc_rnd_t rnd)
+{
+   known_signs_t ks = {1, 1};
+   int inex, inex_ref;
+
+   if (mpc_mul_limbs (z, x, y, rnd, &inex)) {
+      inex_ref = mpc_mul_naive (ref, x, y, rnd);
+      if (!same_mpc_value (z, ref, ks) || inex != inex_ref)
+         report ("mul", rnd, inex, inex_ref);
+   }
+   if (mpc_sqr_limbs (z, x, rnd, &inex)) {
+      inex_ref = mpc_mul_naive (ref, x, x, rnd);
+      if (!same_mpc_value (z, ref, ks) || inex != inex_ref)
+         report ("sqr", rnd, inex, inex_ref);
+   }
+   if (mpc_norm_limbs (n, x, MPC_RND_RE (rnd), &inex)) {
+      inex_ref = mpfr_fmma (nref, mpc_realref (x), mpc_realref (x),
+                            mpc_imagref (x), mpc_imagref (x),
+                            MPC_RND_RE (rnd));
+      if (!mpfr_equal_p (n, nref) || inex != inex_ref)
+         report ("norm", rnd, inex, inex_ref);
+   }
+   if (mpc_fma_limbs (z, x, y, c, rnd, &inex)) {
+      inex_ref = mpc_fma_naive (ref, x, y, c, rnd);
+      if (!same_mpc_value (z, ref, ks) || inex != inex_ref)
+         report ("fma", rnd, inex, inex_ref);
+   }
+}
+
+static void
+check_all (mpfr_prec_t px, mpfr_prec_t py, mpfr_prec_t pz,
+           mpfr_exp_t emin, mpfr_exp_t emax)
+{
+   int i, j, k;
+
+   mpc_set_prec (x, px);
+   mpc_set_prec (y, py);
+   mpc_set_prec (c, py);
+   mpc_set_prec (z, pz);
+   mpc_set_prec (ref, pz);
+   mpfr_set_prec (n, pz);
+   mpfr_set_prec (nref, pz);
+   for (i = 0; i < 20; i++) {
+      test_default_random (x, emin, emax, 128, 0);
+      test_default_random (y, emin, emax, 128, 0);
+      test_default_random (c, emin, emax, 128, 16);
+      if (i % 4 == 1) {
+         /* provoke a cancellation in the real part of x*y */
+         mpfr_mul (mpc_imagref (y), mpc_realref (x), mpc_realref (y),
+                   MPFR_RNDN);
+         mpfr_div (mpc_imagref (y), mpc_imagref (y), mpc_imagref (x),
+                   MPFR_RNDN);
+      }
+      else if (i % 4 == 2) {
+         /* provoke a cancellation in the real part of x*y+c */
+         mpfr_fmms (mpc_realref (c), mpc_imagref (x), mpc_imagref (y),
+                    mpc_realref (x), mpc_realref (y), MPFR_RNDN);
+      }
+      else if (i % 4 == 3) {
+         /* and in the real part of x^2 */
+         mpfr_set (mpc_imagref (x), mpc_realref (x), MPFR_RNDN);
+         mpfr_nextabove (mpc_imagref (x));
+      }
+      for (j = 0; j < 5; j++)
+         for (k = 0; k < 5; k++)
+            check (MPC_RND (rnds [j], rnds [k]));
+   }
+}
+
+int
+main (void)
+{
+   mpfr_prec_t p;
+
+   test_start ();
+
+   mpc_init2 (x, 2);
+   mpc_init2 (y, 2);
+   mpc_init2 (c, 2);
+   mpc_init2 (z, 2);
+   mpc_init2 (ref, 2);
+   mpfr_init2 (n, 2);
+   mpfr_init2 (nref, 2);
+
+   for (p = 2; p <= 2 * GMP_NUMB_BITS; p += 7) {
+      check_all (p, p, p, -10, 10);
+      check_all (p, p, p, -200, 200);
+   }
+   check_all (GMP_NUMB_BITS, GMP_NUMB_BITS, GMP_NUMB_BITS, -10, 10);
+   check_all (2 * GMP_NUMB_BITS, 2 * GMP_NUMB_BITS, 2 * GMP_NUMB_BITS,
+              -10, 10);
+   check_all (GMP_NUMB_BITS, 2 * GMP_NUMB_BITS, GMP_NUMB_BITS, -10, 10);
+   check_all (2 * GMP_NUMB_BITS, GMP_NUMB_BITS, 2 * GMP_NUMB_BITS,
+              -10, 10);
+   check_all (2 * GMP_NUMB_BITS, 2 * GMP_NUMB_BITS, 17, -10, 10);
+   check_all (17, 2 * GMP_NUMB_BITS, 2 * GMP_NUMB_BITS, -300, 300);
+
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (c);
+   mpc_clear (z);
+   mpc_clear (ref);
+   mpfr_clear (n);
+   mpfr_clear (nref);
+
+   test_end ();
+
+   return 0;
+}
@@ -1,6 +1,6 @@
 /* tmul -- test file for mpc_mul.
 
-Copyright (C) 2002, 2005, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2020 INRIA
+Copyright (C) 2002, 2005, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2020, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -26,21 +26,23 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 
 static void
 cmpmul (mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
-   /* computes the product of x and y with the naive and Karatsuba methods */
-   /* using the rounding mode rnd and compares the results and return      */
-   /* values.                                                              */
+   /* computes the product of x and y with the naive and both Karatsuba    */
+   /* methods using the rounding mode rnd and compares the results and     */
+   /* return values.                                                       */
    /* In our current test suite, the real and imaginary parts of x and y   */
    /* all have the same precision, and we use this precision also for the  */
    /* result.                                                              */
 {
-   mpc_t z, t;
-   int   inex_z, inex_t;
+   mpc_t z, t, u;
+   int   inex_z, inex_t, inex_u;
 
    mpc_init2 (z, MPC_MAX_PREC (x));
    mpc_init2 (t, MPC_MAX_PREC (x));
+   mpc_init2 (u, MPC_MAX_PREC (x));
 
    inex_z = mpc_mul_naive (z, x, y, rnd);
    inex_t = mpc_mul_karatsuba (t, x, y, rnd);
+   inex_u = mpc_mul_karatsuba3 (u, x, y, rnd);
 
    if (mpc_cmp (z, t) != 0 || inex_z != inex_t) {
       fprintf (stderr, "mul_naive and mul_karatsuba differ for rnd=(%s,%s)\n",
@@ -56,9 +58,24 @@ cmpmul (mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
       }
       exit (1);
    }
+   if (mpc_cmp (z, u) != 0 || inex_z != inex_u) {
+      fprintf (stderr, "mul_naive and mul_karatsuba3 differ for rnd=(%s,%s)\n",
+               mpfr_print_rnd_mode(MPC_RND_RE(rnd)),
+               mpfr_print_rnd_mode(MPC_RND_IM(rnd)));
+      MPC_OUT (x);
+      MPC_OUT (y);
+      MPC_OUT (z);
+      MPC_OUT (u);
+      if (inex_z != inex_u) {
+         fprintf (stderr, "inex_re (z): %s\n", MPC_INEX_STR (inex_z));
+         fprintf (stderr, "inex_re (u): %s\n", MPC_INEX_STR (inex_u));
+      }
+      exit (1);
+   }
 
    mpc_clear (z);
    mpc_clear (t);
+   mpc_clear (u);
 }
 
 
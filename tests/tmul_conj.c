@@ -0,0 +1,131 @@
+/* tmul_conj -- test file for mpc_mul_conj.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-tests.h"
+
+/* compare mpc_mul_conj with mpc_mul and an explicit conjugate, also with
+   the result in either operand */
+static void
+check_random (void)
+{
+  known_signs_t ks = {1, 1};
+  mpfr_prec_t prec;
+  mpc_t x, y, yc, z, ref;
+  int i, rnd_re, rnd_im, inex, inex_ref;
+  mpc_rnd_t rnd;
+
+  mpc_init2 (x, 2);
+  mpc_init2 (y, 2);
+  mpc_init2 (yc, 2);
+  mpc_init2 (z, 2);
+  mpc_init2 (ref, 2);
+
+  for (prec = 2; prec < 1000; prec = (mpfr_prec_t) (prec * 1.3 + 1))
+    for (i = 0; i < 10; i++)
+      {
+        mpc_set_prec (x, prec);
+        mpc_set_prec (y, prec);
+        mpc_set_prec (yc, prec);
+        mpc_set_prec (z, prec);
+        mpc_set_prec (ref, prec);
+        test_default_random (x, -100, 100, 128, 25);
+        if (i == 0)
+          mpc_set (y, x, MPC_RNDNN);
+        else
+          test_default_random (y, -100, 100, 128, 25);
+        mpc_conj (yc, y, MPC_RNDNN);
+        for (rnd_re = 0; rnd_re < 4; rnd_re ++)
+          for (rnd_im = 0; rnd_im < 4; rnd_im ++)
+            {
+              rnd = MPC_RND (rnd_re, rnd_im);
+              inex_ref = mpc_mul (ref, x, yc, rnd);
+              inex = mpc_mul_conj (z, x, y, rnd);
+              if (!same_mpc_value (z, ref, ks) || inex != inex_ref)
+                {
+                  printf ("mpc_mul_conj failed for rnd=(%s,%s)\n",
+                          mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+                          mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+                  MPC_OUT (x);
+                  MPC_OUT (y);
+                  MPC_OUT (z);
+                  MPC_OUT (ref);
+                  exit (1);
+                }
+              mpc_set (z, y, MPC_RNDNN);
+              inex = mpc_mul_conj (z, x, z, rnd);
+              if (!same_mpc_value (z, ref, ks) || inex != inex_ref)
+                {
+                  printf ("mpc_mul_conj failed with the result in the "
+                          "second operand\n");
+                  MPC_OUT (x);
+                  MPC_OUT (y);
+                  MPC_OUT (z);
+                  MPC_OUT (ref);
+                  exit (1);
+                }
+              if (i == 0)
+                {
+                  /* x*conj(x) with a single variable */
+                  mpc_set (z, x, MPC_RNDNN);
+                  inex = mpc_mul_conj (z, z, z, rnd);
+                  if (!same_mpc_value (z, ref, ks) || inex != inex_ref)
+                    {
+                      printf ("mpc_mul_conj failed for x*conj(x)\n");
+                      MPC_OUT (x);
+                      MPC_OUT (z);
+                      MPC_OUT (ref);
+                      exit (1);
+                    }
+                }
+            }
+      }
+
+  mpc_clear (x);
+  mpc_clear (y);
+  mpc_clear (yc);
+  mpc_clear (z);
+  mpc_clear (ref);
+}
+
+#define MPC_FUNCTION_CALL                                               \
+  P[0].mpc_inex = mpc_mul_conj (P[1].mpc, P[2].mpc, P[3].mpc, P[4].mpc_rnd)
+#define MPC_FUNCTION_CALL_REUSE_OP1                                     \
+  P[0].mpc_inex = mpc_mul_conj (P[1].mpc, P[1].mpc, P[3].mpc, P[4].mpc_rnd)
+#define MPC_FUNCTION_CALL_REUSE_OP2                                     \
+  P[0].mpc_inex = mpc_mul_conj (P[1].mpc, P[2].mpc, P[1].mpc, P[4].mpc_rnd)
+
+#include "data_check.tpl"
+#include "tgeneric.tpl"
+
+int
+main (void)
+{
+  test_start ();
+
+  check_random ();
+
+  data_check_template ("mul_conj.dsc", "mul_conj.dat");
+
+  tgeneric_template ("mul_conj.dsc", 2, 1024, 41, 256);
+
+  test_end ();
+
+  return 0;
+}
@@ -1,6 +1,6 @@
 /* tpow_z -- test file for mpc_pow_z.
 
-Copyright (C) 2009, 2011, 2012, 2013 INRIA
+Copyright (C) 2009, 2011, 2012, 2013, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -24,8 +24,10 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 static void
 test_large (void)
 {
-  mpc_t z;
+  mpc_t z, x, y, r;
   mpz_t t;
+  int i, inex, inex_z;
+  known_signs_t ks = {1, 1};
 
   mpc_init2 (z, 5);
   mpz_init_set_ui (t, 1ul);
@@ -39,6 +41,62 @@ test_large (void)
     exit (1);
   }
 
+  /* exponent of several limbs and base close to the unit circle, checked
+     against mpc_pow with the same exponent */
+  mpc_set_prec (z, 53);
+  mpc_init2 (x, 53);
+  mpc_init2 (r, 53);
+  mpc_init2 (y, 3 * sizeof (long) * CHAR_BIT);
+  mpc_set_d_d (x, 0.6, 0.8, MPC_RNDNN);
+  mpz_set_ui (t, 12345ul);
+  mpz_mul_2exp (t, t, 2 * sizeof (long) * CHAR_BIT);
+  mpz_add_ui (t, t, 6789ul);
+  for (i = 0; i < 2; i++) {
+    mpc_set_z (y, t, MPC_RNDNN);
+    inex_z = mpc_pow_z (z, x, t, MPC_RNDNN);
+    inex = mpc_pow (r, x, y, MPC_RNDNN);
+    if (mpc_cmp (z, r) != 0 || inex_z != inex) {
+      printf ("Error for mpc_pow_z (x, large) with large = ");
+      mpz_out_str (stdout, 10, t);
+      printf ("\ngot      ");
+      MPC_OUT (z);
+      printf ("expected ");
+      MPC_OUT (r);
+      exit (1);
+    }
+    mpz_neg (t, t);
+  }
+
+  /* real base and negative exponent wider than a long, for which the
+     exponent must be passed to mpc_pow with an imaginary part of +0 */
+  mpz_set_si (t, -1l);
+  mpz_mul_2exp (t, t, 100);
+  mpc_set_d_d (x, 0.5, 0.0, MPC_RNDNN);
+  mpfr_set_inf (mpc_realref (r), +1);
+  mpfr_set_zero (mpc_imagref (r), -1);
+  mpc_pow_z (z, x, t, MPC_RNDNN);
+  if (!same_mpc_value (z, r, ks)) {
+    printf ("Error for mpc_pow_z (0.5, -2^100)\ngot      ");
+    MPC_OUT (z);
+    printf ("expected ");
+    MPC_OUT (r);
+    exit (1);
+  }
+  mpc_set_d_d (x, -5.96, 0.0, MPC_RNDNN);
+  mpfr_set_zero (mpc_realref (r), +1);
+  mpfr_set_zero (mpc_imagref (r), +1);
+  mpc_pow_z (z, x, t, MPC_RNDNN);
+  if (!same_mpc_value (z, r, ks)) {
+    printf ("Error for mpc_pow_z (-5.96, -2^100)\ngot      ");
+    MPC_OUT (z);
+    printf ("expected ");
+    MPC_OUT (r);
+    exit (1);
+  }
+
+  mpc_clear (y);
+  mpc_clear (r);
+  mpc_clear (x);
   mpc_clear (z);
   mpz_clear (t);
 }
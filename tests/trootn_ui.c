@@ -0,0 +1,98 @@
+/* trootn_ui -- test file for mpc_rootn_ui.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+#include "mpc-tests.h"
+
+#define MPC_FUNCTION_CALL                                               \
+  P[0].mpc_inex = mpc_rootn_ui (P[1].mpc, P[2].mpc, P[3].ui, P[4].mpc_rnd)
+#define MPC_FUNCTION_CALL_REUSE_OP1                                     \
+  P[0].mpc_inex = mpc_rootn_ui (P[1].mpc, P[1].mpc, P[3].ui, P[4].mpc_rnd)
+
+#include "data_check.tpl"
+#include "tgeneric.tpl"
+
+/* check that the n-th root of w^n is w with a zero ternary value, for
+   random Gaussian integers w of at most 8 bits in the principal sector */
+static void
+check_exact (void)
+{
+  mpc_t w, z, r;
+  mpfr_t a, b;
+  unsigned long n;
+  int i, inex;
+
+  mpc_init2 (w, 8);
+  mpc_init2 (r, 8);
+  mpfr_init2 (a, 64);
+  mpfr_init2 (b, 64);
+  for (n = 3; n <= 12; n++)
+    {
+      mpc_init2 (z, 9 * n);
+      for (i = 0; i < 100; i++)
+        {
+          mpc_set_si_si (w, (long) gmp_urandomb_ui (rands, 8),
+                         (long) gmp_urandomb_ui (rands, 8) - 128, MPC_RNDNN);
+          /* the root is principal if -pi/n < arg (w) <= pi/n */
+          mpc_arg (a, w, MPFR_RNDN);
+          mpfr_abs (a, a, MPFR_RNDN);
+          mpfr_const_pi (b, MPFR_RNDN);
+          mpfr_div_ui (b, b, n, MPFR_RNDN);
+          if (mpc_cmp_si (w, 0) == 0 || mpfr_cmp (a, b) >= 0)
+            continue;
+          inex = mpc_pow_ui (z, w, n, MPC_RNDNN);
+          MPC_ASSERT (inex == 0);
+          inex = mpc_rootn_ui (r, z, n, MPC_RNDNN);
+          if (inex != 0 || mpc_cmp (r, w) != 0)
+            {
+              printf ("Error in mpc_rootn_ui for n=%lu and z=", n);
+              mpc_out_str (stdout, 16, 0, z, MPC_RNDNN);
+              printf ("\nexpected ");
+              mpc_out_str (stdout, 16, 0, w, MPC_RNDNN);
+              printf (" with inex=0\ngot      ");
+              mpc_out_str (stdout, 16, 0, r, MPC_RNDNN);
+              printf (" with inex=%d\n", inex);
+              exit (1);
+            }
+        }
+      mpc_clear (z);
+    }
+  mpfr_clear (a);
+  mpfr_clear (b);
+  mpc_clear (r);
+  mpc_clear (w);
+}
+
+int
+main (void)
+{
+  test_start ();
+
+  check_exact ();
+
+  data_check_template ("rootn_ui.dsc", "rootn_ui.dat");
+
+  /* Random values of n are large, so that the root is close to 1; start
+     only at 20 bits to avoid that the extra-precise result is always
+     subject to double rounding. */
+  tgeneric_template ("rootn_ui.dsc", 20, 512, 7, 128);
+
+  test_end ();
+
+  return 0;
+}
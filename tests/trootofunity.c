@@ -57,6 +57,90 @@ check (unsigned long int n)
    mpc_clear (zero);
 }
 
+static const mpfr_rnd_t rnds [] =
+   { MPFR_RNDN, MPFR_RNDZ, MPFR_RNDU, MPFR_RNDD, MPFR_RNDA };
+
+static void
+check_table (unsigned long int n, mpfr_prec_t prec, int mixed, mpc_rnd_t rnd)
+   /* checks mpc_rootofunity_table against mpc_rootofunity; if mixed is
+      non-zero, the parts of the elements have different precisions */
+{
+   mpc_t *z, ref;
+   mpc_ptr *pz;
+   int *inex, ret, any = 0;
+   unsigned long int j;
+   known_signs_t ks = {1, 1};
+
+   z = (mpc_t *) malloc (n * sizeof (mpc_t));
+   pz = (mpc_ptr *) malloc (n * sizeof (mpc_ptr));
+   inex = (int *) malloc (n * sizeof (int));
+   mpc_init2 (ref, 2);
+   for (j = 0; j < n; j++) {
+      if (mixed)
+         mpc_init3 (z [j], prec + (j * 7) % 23, prec + (j * 13) % 31);
+      else
+         mpc_init2 (z [j], prec);
+      pz [j] = z [j];
+   }
+
+   ret = mpc_rootofunity_table (pz, n, inex, rnd);
+   for (j = 0; j < n; j++) {
+      mpc_set_prec (ref, 2);
+      mpfr_set_prec (mpc_realref (ref), mpfr_get_prec (mpc_realref (z [j])));
+      mpfr_set_prec (mpc_imagref (ref), mpfr_get_prec (mpc_imagref (z [j])));
+      if (mpc_rootofunity (ref, n, j, rnd) != inex [j]
+          || !same_mpc_value (z [j], ref, ks)) {
+         printf ("mpc_rootofunity_table and mpc_rootofunity differ for "
+                 "n=%lu, j=%lu\nfor rounding mode (%s, %s)\n", n, j,
+                 mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+                 mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+         MPC_OUT (z [j]);
+         MPC_OUT (ref);
+         printf ("inex = %i\n", inex [j]);
+         exit (1);
+      }
+      if (inex [j] != 0)
+         any = 1;
+   }
+   if ((ret != 0) != any
+       || (mpc_rootofunity_table (pz, n, NULL, rnd) != 0) != any) {
+      printf ("mpc_rootofunity_table returns %i for n=%lu, but the ternary "
+              "values are %s\n", ret, n, any ? "not all 0" : "all 0");
+      exit (1);
+   }
+
+   for (j = 0; j < n; j++)
+      mpc_clear (z [j]);
+   mpc_clear (ref);
+   free (z);
+   free (pz);
+   free (inex);
+}
+
+static void
+check_tables (void)
+{
+   unsigned long int n;
+   int i, j;
+
+   MPC_ASSERT (mpc_rootofunity_table (NULL, 0, NULL, MPC_RNDNN) == 0);
+   for (n = 1; n <= 50; n++)
+      for (i = 0; i < 5; i++)
+         for (j = 0; j < 5; j++) {
+            check_table (n, 2 + (n * 5 + i) % 100, 0,
+                         MPC_RND (rnds [i], rnds [j]));
+            check_table (n, 53, 1, MPC_RND (rnds [i], rnds [j]));
+         }
+   for (i = 0; i < 5; i++) {
+      check_table (96, 113, 0, MPC_RND (rnds [i], rnds [4 - i]));
+      check_table (360, 30, 1, MPC_RND (rnds [i], rnds [i]));
+      check_table (1000, 200, 0, MPC_RND (rnds [i], rnds [(i + 1) % 5]));
+      check_table (1026, 64, 1, MPC_RND (rnds [i], rnds [(i + 2) % 5]));
+   }
+   check_table (4096, 53, 0, MPC_RNDNN);
+   check_table (4095, 100, 0, MPC_RNDZZ);
+}
+
 
 int
 main (void)
@@ -68,6 +152,8 @@ main (void)
 
    test_start ();
 
+   check_tables ();
+
    data_check_template ("rootofunity.dsc", "rootofunity.dat");
 
    /* Avoid checking roots of unity of high order at very low precision,
@@ -0,0 +1,123 @@
+/* tscratch -- test file for mpc_scratch_init, mpc_scratch_clear and
+   mpc_scratch_attach.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-tests.h"
+
+typedef int (*func_t) (mpc_ptr, mpc_srcptr, mpc_rnd_t);
+
+static const mpfr_rnd_t rnds [] =
+   { MPFR_RNDN, MPFR_RNDZ, MPFR_RNDU, MPFR_RNDD, MPFR_RNDA };
+
+static mpc_scratch_t scratch;
+static mpc_t x, y, z, ref;
+
+static int
+pow_wrapper (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   return mpc_pow (rop, op, y, rnd);
+}
+
+/* Check that f (x) yields the same result and ternary value with and
+   without the scratch context attached, and that the scratch context
+   gets back all of its variables. */
+static void
+check_func (const char *name, func_t f, mpc_rnd_t rnd)
+{
+   known_signs_t ks = {1, 1};
+   int inex, inex_ref;
+
+   inex_ref = f (ref, x, rnd);
+   MPC_ASSERT (mpc_scratch_attach (scratch) == NULL);
+   inex = f (z, x, rnd);
+   MPC_ASSERT (scratch->used == 0);
+#ifdef HAVE_THREAD_LOCAL
+   MPC_ASSERT (mpc_scratch_attach (NULL) == scratch);
+#else
+   /* without thread local storage, no context is ever attached */
+   MPC_ASSERT (mpc_scratch_attach (NULL) == NULL);
+#endif
+
+   if (!same_mpc_value (z, ref, ks) || inex != inex_ref) {
+      printf ("mpc_%s differs with a scratch context attached\n"
+              "for rounding mode (%s, %s)\n", name,
+              mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+              mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+      MPC_OUT (x);
+      MPC_OUT (z);
+      MPC_OUT (ref);
+      printf ("inex = %i, expected %i\n", inex, inex_ref);
+      exit (1);
+   }
+}
+
+static void
+check_all (mpfr_prec_t prec)
+{
+   int i, j, k;
+   mpc_rnd_t rnd;
+
+   mpc_set_prec (x, prec);
+   mpc_set_prec (y, prec);
+   mpc_set_prec (z, prec);
+   mpc_set_prec (ref, prec);
+   for (i = 0; i < 10; i++) {
+      test_default_random (x, -20, 20, 128, 16);
+      test_default_random (y, -5, 5, 128, 16);
+      for (j = 0; j < 5; j++)
+         for (k = 0; k < 5; k++) {
+            rnd = MPC_RND (rnds [j], rnds [k]);
+            check_func ("exp", mpc_exp, rnd);
+            check_func ("log", mpc_log, rnd);
+            check_func ("log2", mpc_log2, rnd);
+            check_func ("tan", mpc_tan, rnd);
+            check_func ("sqrt", mpc_sqrt, rnd);
+            check_func ("atan", mpc_atan, rnd);
+            check_func ("pow", pow_wrapper, rnd);
+         }
+   }
+}
+
+int
+main (void)
+{
+   test_start ();
+
+   mpc_init2 (x, 2);
+   mpc_init2 (y, 2);
+   mpc_init2 (z, 2);
+   mpc_init2 (ref, 2);
+   mpc_scratch_init (scratch);
+
+   /* the variables of the scratch context grow with the precision */
+   check_all (17);
+   check_all (1000);
+   check_all (53);
+
+   mpc_scratch_clear (scratch);
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (z);
+   mpc_clear (ref);
+
+   test_end ();
+
+   return 0;
+}
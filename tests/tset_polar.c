@@ -0,0 +1,85 @@
+/* tset_polar -- test file for mpc_set_polar.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+#include "mpc-tests.h"
+
+#define MPC_FUNCTION_CALL                                               \
+  P[0].mpc_inex = mpc_set_polar (P[1].mpc, P[2].mpfr, P[3].mpfr, P[4].mpc_rnd)
+
+#include "data_check.tpl"
+#include "tgeneric.tpl"
+
+/* check that mpc_set_polar with r = 1 agrees with mpc_cis */
+static void
+check_cis (void)
+{
+  mpc_t z, t;
+  mpfr_t r, theta;
+  mpfr_prec_t p;
+  int i, inex_polar, inex_cis;
+  mpc_rnd_t rnd;
+
+  mpfr_init2 (r, 2);
+  mpfr_set_ui (r, 1, MPFR_RNDN);
+  for (p = 2; p <= 256; p += 17)
+    {
+      mpc_init2 (z, p);
+      mpc_init2 (t, p);
+      mpfr_init2 (theta, p);
+      for (i = 0; i < 20; i++)
+        {
+          test_random_mpfr (theta, -128, 128, 128);
+          rnd = MPC_RND (gmp_urandomb_ui (rands, 2), gmp_urandomb_ui (rands, 2));
+          inex_polar = mpc_set_polar (z, r, theta, rnd);
+          inex_cis = mpc_cis (t, theta, rnd);
+          if (inex_polar != inex_cis || mpc_cmp (z, t) != 0)
+            {
+              printf ("mpc_set_polar and mpc_cis differ for theta=");
+              mpfr_out_str (stdout, 16, 0, theta, MPFR_RNDN);
+              printf (" and rnd=%d\n", rnd);
+              printf ("mpc_set_polar gives ");
+              mpc_out_str (stdout, 16, 0, z, MPC_RNDNN);
+              printf (" with inex=%d\nmpc_cis gives       ", inex_polar);
+              mpc_out_str (stdout, 16, 0, t, MPC_RNDNN);
+              printf (" with inex=%d\n", inex_cis);
+              exit (1);
+            }
+        }
+      mpc_clear (z);
+      mpc_clear (t);
+      mpfr_clear (theta);
+    }
+  mpfr_clear (r);
+}
+
+int
+main (void)
+{
+  test_start ();
+
+  check_cis ();
+
+  data_check_template ("set_polar.dsc", "set_polar.dat");
+
+  tgeneric_template ("set_polar.dsc", 2, 512, 7, 128);
+
+  test_end ();
+
+  return 0;
+}
@@ -1,6 +1,6 @@
 /* tsum -- test file for mpc_sum.
 
-Copyright (C) 2018 INRIA
+Copyright (C) 2018, 2026 INRIA
 
 This file is part of GNU MPC.
 
@@ -20,6 +20,8 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 
 #include "mpc-tests.h"
 
+#define NMAX 20
+
 static void
 check_special (void)
 {
@@ -55,12 +57,197 @@ check_special (void)
   mpc_clear (res);
 }
 
+static void
+check_acc (const char *s, mpc_sumacc_srcptr acc, mpc_ptr *z,
+           unsigned long n, mpc_rnd_t rnd, mpc_ptr res, mpc_ptr ref)
+{
+  known_signs_t ks = {1, 1};
+  int inex, inex_ref;
+
+  inex = mpc_sumacc_get (res, acc, rnd);
+  inex_ref = reference_sum (ref, z, n, rnd);
+  if (!same_mpc_value (res, ref, ks) || inex != inex_ref)
+    {
+      printf ("mpc_sumacc_get differs from the reference (%s) for %lu "
+              "terms\nand rounding mode (%s, %s)\n", s, n,
+              mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+              mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+      MPC_OUT (res);
+      MPC_OUT (ref);
+      printf ("inex = %d, expected %d\n", inex, inex_ref);
+      exit (1);
+    }
+}
+
+/* check the accumulators on random vectors of length n, with exponents
+   in [-emax, emax] and special values if special is non-zero, and mpc_sum
+   on the whole vector */
+static void
+check_random (mpfr_prec_t prec, unsigned long n, mpfr_exp_t emax,
+              int special)
+{
+  mpc_t z[2 * NMAX], res, ref;
+  mpc_ptr t[2 * NMAX];
+  mpc_sumacc_t acc, acc2;
+  unsigned long i, k;
+  mpc_rnd_t rnd;
+  int inex, inex_ref;
+  known_signs_t ks = {1, 1};
+
+  for (i = 0; i < 2 * n; i++)
+    {
+      mpc_init2 (z[i], prec + (mpfr_prec_t) (i % 7) * 10);
+      test_default_random (z[i], -emax, emax, 128, 25);
+      if (i % 3 == 1)
+        /* provoke cancellations */
+        mpc_neg (z[i], z[i - 1], MPC_RNDNN);
+      if (special && i % 5 == 2)
+        mpfr_set_zero (mpc_realref (z[i]), (i % 3 == 0) ? +1 : -1);
+      if (special && i % 7 == 3)
+        mpfr_set_zero (mpc_imagref (z[i]), (i % 2 == 0) ? +1 : -1);
+      if (special && i == n - 1 && n % 4 == 1)
+        mpfr_set_inf (mpc_realref (z[i]), (n % 8 == 1) ? +1 : -1);
+      if (special && i == 2 * n - 1 && n % 3 == 0)
+        mpfr_set_inf (mpc_imagref (z[i]), -1);
+      if (special && i == n && n % 5 == 0)
+        mpfr_set_nan (mpc_realref (z[i]));
+      t[i] = z[i];
+    }
+  mpc_init2 (res, prec);
+  mpc_init2 (ref, prec);
+
+  /* one term at a time, getting all partial sums */
+  mpc_sumacc_init (acc);
+  for (i = 0; i <= n; i++)
+    {
+      rnd = MPC_RND (i % 5 == 4 ? MPFR_RNDA : (mpfr_rnd_t) (i % 4),
+                     (mpfr_rnd_t) ((i + n) % 4));
+      check_acc ("add", acc, t, i, rnd, res, ref);
+      if (i < n)
+        mpc_sumacc_add (acc, t[i]);
+    }
+
+  /* the second half in chunks, and merged with itself */
+  mpc_sumacc_init (acc2);
+  for (k = n; k < 2 * n; k += 3)
+    mpc_sumacc_add_vec (acc2, t + k, (k + 3 <= 2 * n) ? 3 : 2 * n - k);
+  check_acc ("add_vec", acc2, t + n, n, MPC_RNDZU, res, ref);
+  mpc_sumacc_merge (acc, acc2);
+  check_acc ("merge", acc, t, 2 * n, MPC_RNDDN, res, ref);
+  mpc_sumacc_merge (acc2, acc2);
+  for (i = 0; i < n; i++)
+    t[i] = z[n + i];
+  check_acc ("self merge", acc2, t, 2 * n, MPC_RNDNA, res, ref);
+  mpc_sumacc_clear (acc);
+  mpc_sumacc_clear (acc2);
+
+  /* mpc_sum with the result in the input z[0], which has precision
+     prec */
+  for (i = 0; i < 2 * n; i++)
+    t[i] = z[i];
+  inex_ref = reference_sum (ref, t, 2 * n, MPC_RNDUD);
+  inex = mpc_sum (z[0], t, 2 * n, MPC_RNDUD);
+  if (!same_mpc_value (z[0], ref, ks) || inex != inex_ref)
+    {
+      printf ("mpc_sum differs from the reference\n");
+      MPC_OUT (z[0]);
+      MPC_OUT (ref);
+      printf ("inex = %d, expected %d\n", inex, inex_ref);
+      exit (1);
+    }
+
+  for (i = 0; i < 2 * n; i++)
+    mpc_clear (z[i]);
+  mpc_clear (res);
+  mpc_clear (ref);
+}
+
+/* check the accumulators on 3n random terms in three clusters of
+   exponents around -e, 0 and e, with cancellations inside each cluster;
+   for large e, the terms of one cluster do not fit into the window of
+   the exact sum holding another one */
+static void
+check_far (mpfr_prec_t prec, unsigned long n, mpfr_exp_t e)
+{
+  mpc_t z[3 * NMAX], res, ref;
+  mpc_ptr t[6 * NMAX];
+  mpc_sumacc_t acc, acc2;
+  unsigned long i;
+
+  for (i = 0; i < 3 * n; i++)
+    {
+      mpc_init2 (z[i], prec + (mpfr_prec_t) (i % 5) * 30);
+      if (i >= 3 && i % 4 == 0)
+        mpc_neg (z[i], z[i - 3], MPC_RNDNN);
+      else
+        {
+          test_default_random (z[i], -10, 10, 128, 0);
+          mpfr_mul_2si (mpc_realref (z[i]), mpc_realref (z[i]),
+                        ((mpfr_exp_t) (i % 3) - 1) * e, MPFR_RNDN);
+          mpfr_mul_2si (mpc_imagref (z[i]), mpc_imagref (z[i]),
+                        (1 - (mpfr_exp_t) (i % 3)) * e, MPFR_RNDN);
+        }
+      t[i] = z[i];
+      t[3 * n + i] = z[i];
+    }
+  mpc_init2 (res, prec);
+  mpc_init2 (ref, prec);
+
+  mpc_sumacc_init (acc);
+  for (i = 0; i < 3 * n; i++)
+    {
+      mpc_sumacc_add (acc, t[i]);
+      check_acc ("far", acc, t, i + 1,
+                 MPC_RND ((mpfr_rnd_t) (i % 4), (mpfr_rnd_t) (i % 5 % 4)),
+                 res, ref);
+    }
+  mpc_sumacc_init (acc2);
+  mpc_sumacc_add_vec (acc2, t, 3 * n);
+  mpc_sumacc_merge (acc2, acc);
+  check_acc ("far merge", acc2, t, 6 * n, MPC_RNDZU, res, ref);
+  mpc_sumacc_merge (acc, acc);
+  check_acc ("far self merge", acc, t, 6 * n, MPC_RNDDN, res, ref);
+  mpc_sumacc_clear (acc);
+  mpc_sumacc_clear (acc2);
+
+  for (i = 0; i < 3 * n; i++)
+    mpc_clear (z[i]);
+  mpc_clear (res);
+  mpc_clear (ref);
+}
+
 int
 main (void)
 {
+  unsigned long n;
+  mpfr_exp_t emin, emax;
+
   test_start ();
 
   check_special ();
+  for (n = 1; n <= NMAX; n++)
+    {
+      check_random (2, n, 60, 0);
+      check_random (53, n, 60, 0);
+      check_random (300, n, 60, 0);
+      check_random (53, n, 60, 1);
+      check_random (53, n, 5000, 0);
+      check_far (53, n, 1000);
+      check_far (53, n, 1l << 29);
+    }
+
+  /* exponents far apart in the extended exponent range */
+  emin = mpfr_get_emin ();
+  emax = mpfr_get_emax ();
+  mpfr_set_emin (mpfr_get_emin_min ());
+  mpfr_set_emax (mpfr_get_emax_max ());
+  for (n = 1; n <= NMAX; n++)
+    {
+      check_far (2, n, mpfr_get_emax_max () / 2);
+      check_far (200, n, mpfr_get_emax_max () / 2);
+    }
+  mpfr_set_emin (emin);
+  mpfr_set_emax (emax);
 
   test_end ();
 
@@ -0,0 +1,222 @@
+/* tvec -- test file for mpc_vec_add, mpc_vec_mul, mpc_vec_sqr, mpc_vec_fma
+   and mpc_vec_div.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-tests.h"
+
+#define N 24
+
+static const mpfr_rnd_t rnds [] =
+   { MPFR_RNDN, MPFR_RNDZ, MPFR_RNDU, MPFR_RNDD, MPFR_RNDA };
+
+static mpc_t x [N], y [N], w [N], z [N], ref [N];
+static mpc_ptr px [N], py [N], pw [N], pz [N];
+
+/* Fill x, y and w with random numbers of precision prec, among which some
+   special values and some cases with exact zero parts in the result. */
+static void
+random_vectors (mpfr_prec_t prec)
+{
+   int i;
+
+   for (i = 0; i < N; i++) {
+      mpc_set_prec (x [i], prec);
+      mpc_set_prec (y [i], prec);
+      mpc_set_prec (w [i], prec);
+      mpc_set_prec (z [i], prec);
+      mpc_set_prec (ref [i], prec);
+      test_default_random (x [i], -20, 20, 128, 16);
+      test_default_random (y [i], -20, 20, 128, 16);
+      test_default_random (w [i], -20, 20, 128, 16);
+   }
+   /* (1+i)^2 and (1+i)*(1+i) have a zero real part, (1+i)/(1+i) a zero
+      imaginary part, and (1+i)*(1+i) - 2i is zero */
+   mpc_set_ui_ui (x [0], 1, 1, MPC_RNDNN);
+   mpc_set_ui_ui (y [0], 1, 1, MPC_RNDNN);
+   mpc_set_si_si (w [0], 0, -2, MPC_RNDNN);
+   mpc_set_si_si (x [1], 3, -3, MPC_RNDNN);
+   mpc_set_si_si (y [1], 5, 5, MPC_RNDNN);
+   mpfr_set_inf (mpc_realref (x [2]), -1);
+   mpfr_set_nan (mpc_imagref (y [3]));
+   mpfr_set_inf (mpc_imagref (w [4]), +1);
+}
+
+static void
+check_result (const char *name, int i, mpfr_prec_t prec, mpc_rnd_t rnd,
+   int inex, int inex_ref)
+{
+   known_signs_t ks = {1, 1};
+
+   if (!same_mpc_value (z [i], ref [i], ks) || inex != inex_ref) {
+      printf ("mpc_vec_%s and mpc_%s differ for element %i\n"
+              "at precision %lu and rounding mode (%s, %s)\n",
+              name, name, i, (unsigned long) prec,
+              mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+              mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+      MPC_OUT (x [i]);
+      MPC_OUT (y [i]);
+      MPC_OUT (w [i]);
+      MPC_OUT (z [i]);
+      MPC_OUT (ref [i]);
+      printf ("inex = %i, expected %i\n", inex, inex_ref);
+      exit (1);
+   }
+}
+
+static void
+check_return (const char *name, int ret, int any)
+{
+   if ((ret != 0) != (any != 0)) {
+      printf ("mpc_vec_%s returns %i, but the ternary values are %s\n",
+              name, ret, any ? "non-zero" : "zero");
+      exit (1);
+   }
+}
+
+static void
+check_vec (mpfr_prec_t prec, mpc_rnd_t rnd)
+{
+   int inex [N], inex_ref [N];
+   int i, ret, any = 0;
+
+   random_vectors (prec);
+
+   ret = mpc_vec_add (pz, px, py, N, inex, rnd);
+   for (i = 0; i < N; i++) {
+      inex_ref [i] = mpc_add (ref [i], x [i], y [i], rnd);
+      check_result ("add", i, prec, rnd, inex [i], inex_ref [i]);
+      any |= inex_ref [i];
+   }
+   check_return ("add", ret, any);
+   any = 0;
+
+   ret = mpc_vec_mul (pz, px, py, N, inex, rnd);
+   for (i = 0; i < N; i++) {
+      inex_ref [i] = mpc_mul (ref [i], x [i], y [i], rnd);
+      check_result ("mul", i, prec, rnd, inex [i], inex_ref [i]);
+      any |= inex_ref [i];
+   }
+   check_return ("mul", ret, any);
+   any = 0;
+
+   ret = mpc_vec_sqr (pz, px, N, inex, rnd);
+   for (i = 0; i < N; i++) {
+      inex_ref [i] = mpc_sqr (ref [i], x [i], rnd);
+      check_result ("sqr", i, prec, rnd, inex [i], inex_ref [i]);
+      any |= inex_ref [i];
+   }
+   check_return ("sqr", ret, any);
+   any = 0;
+
+   ret = mpc_vec_fma (pz, px, py, pw, N, inex, rnd);
+   for (i = 0; i < N; i++) {
+      inex_ref [i] = mpc_fma (ref [i], x [i], y [i], w [i], rnd);
+      check_result ("fma", i, prec, rnd, inex [i], inex_ref [i]);
+      any |= inex_ref [i];
+   }
+   check_return ("fma", ret, any);
+   any = 0;
+
+   ret = mpc_vec_div (pz, px, py, N, inex, rnd);
+   for (i = 0; i < N; i++) {
+      inex_ref [i] = mpc_div (ref [i], x [i], y [i], rnd);
+      check_result ("div", i, prec, rnd, inex [i], inex_ref [i]);
+      any |= inex_ref [i];
+   }
+   check_return ("div", ret, any);
+
+   /* in place operation, without the ternary values */
+   for (i = 0; i < N; i++)
+      mpc_mul (ref [i], x [i], y [i], rnd);
+   mpc_vec_mul (px, px, py, N, NULL, rnd);
+   for (i = 0; i < N; i++) {
+      mpc_swap (x [i], z [i]);
+      check_result ("mul", i, prec, rnd, 0, 0);
+   }
+}
+
+static void
+check_exact (void)
+{
+   int inex [2];
+   int i;
+
+   for (i = 0; i < 2; i++) {
+      mpc_set_prec (x [i], 10);
+      mpc_set_prec (z [i], 10);
+      mpc_set_ui_ui (x [i], i + 1, 2, MPC_RNDNN);
+   }
+   /* (1+2i)+(1+2i) and (2+2i)+(2+2i) are exact */
+   MPC_ASSERT (mpc_vec_add (pz, px, px, 2, inex, MPC_RNDNN) == 0);
+   MPC_ASSERT (inex [0] == 0 && inex [1] == 0);
+   /* empty vectors */
+   MPC_ASSERT (mpc_vec_div (pz, px, px, 0, NULL, MPC_RNDNN) == 0);
+}
+
+int
+main (void)
+{
+   const mpfr_prec_t precs [] = { 2, 17, 53, 64, 128, 300, 512, 2000 };
+   mpfr_exp_t emin, emax;
+   int i, j, k;
+
+   test_start ();
+
+   for (i = 0; i < N; i++) {
+      mpc_init2 (x [i], 2);
+      mpc_init2 (y [i], 2);
+      mpc_init2 (w [i], 2);
+      mpc_init2 (z [i], 2);
+      mpc_init2 (ref [i], 2);
+      px [i] = x [i];
+      py [i] = y [i];
+      pw [i] = w [i];
+      pz [i] = z [i];
+   }
+
+   check_exact ();
+   for (i = 0; i < (int) (sizeof (precs) / sizeof (precs [0])); i++)
+      for (j = 0; j < 5; j++)
+         for (k = 0; k < 5; k++)
+            check_vec (precs [i], MPC_RND (rnds [j], rnds [k]));
+
+   /* with a reduced exponent range, some products overflow or underflow */
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   mpfr_set_emin (-30);
+   mpfr_set_emax (30);
+   for (j = 0; j < 5; j++)
+      for (k = 0; k < 5; k++)
+         check_vec (53, MPC_RND (rnds [j], rnds [k]));
+   mpfr_set_emin (emin);
+   mpfr_set_emax (emax);
+
+   for (i = 0; i < N; i++) {
+      mpc_clear (x [i]);
+      mpc_clear (y [i]);
+      mpc_clear (w [i]);
+      mpc_clear (z [i]);
+      mpc_clear (ref [i]);
+   }
+
+   test_end ();
+
+   return 0;
+}
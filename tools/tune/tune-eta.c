@@ -0,0 +1,25 @@
+/* tune-eta.c -- mpc_eta_fund with variable thresholds for the tuneup program.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "tuneup.h"
+#define mpc_eta_fund mpc_eta_fund_tune
+#define mpcb_eta_err mpcb_eta_err_tune
+
+#include "../../src/eta.c"
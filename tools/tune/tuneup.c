@@ -0,0 +1,362 @@
+/* tuneup.c -- measure the thresholds of the algorithm switches.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+/* Usage: tuneup [prec]
+
+   The program times the competing code paths of the library on the
+   current machine and writes the resulting thresholds to the standard
+   output in the form of a header file, which "make tune" stores as
+   src/mpc-tuned.h; configure then defines HAVE_MPC_TUNED_H, and the
+   values override the defaults of src/mpc-impl.h.
+   MUL_KARATSUBA_THRESHOLD is obtained by comparing mpc_mul_naive and
+   mpc_mul_karatsuba3 for increasing sizes; the other thresholds depend
+   on the precision as well and are measured at the precision given on
+   the command line, by default 256 bits. */
+
+#include "config.h"
+#include <stdlib.h>
+#include <stdio.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+#include "tuneup.h"
+#include "mpc-impl.h"
+
+long mpc_tune_asin_series_exp;
+long mpc_tune_asin_large_exp;
+long mpc_tune_eta_terms_step;
+long mpc_tune_agm_initial_prec;
+
+int mpc_asin_tune (mpc_ptr, mpc_srcptr, mpc_rnd_t);
+int mpc_eta_fund_tune (mpc_ptr, mpc_srcptr, mpc_rnd_t);
+int mpc_agm_tune (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+
+/* number of random arguments cycled through */
+#define TUNE_NB_ARGS 64
+/* minimal duration of one measurement, in microseconds */
+#define TUNE_MIN_TIME 20000
+/* number of measurements of which the fastest is kept */
+#define TUNE_REPEAT 3
+/* largest size in limbs for MUL_KARATSUBA_THRESHOLD */
+#define TUNE_MUL_MAX_LIMBS 200
+/* number of consecutive sizes for which Karatsuba must be faster */
+#define TUNE_MUL_STABLE 3
+
+typedef int (*tune_func_t) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+
+static mpc_t z [TUNE_NB_ARGS], x [TUNE_NB_ARGS], y [TUNE_NB_ARGS];
+static gmp_randstate_t state;
+
+/* get the time in microseconds */
+static unsigned long
+get_cputime (void)
+{
+#ifdef HAVE_GETRUSAGE
+  struct rusage ru;
+
+  getrusage (RUSAGE_SELF, &ru);
+  return ru.ru_utime.tv_sec * 1000000 + ru.ru_utime.tv_usec
+         +ru.ru_stime.tv_sec * 1000000 + ru.ru_stime.tv_usec;
+#else
+  fprintf (stderr, "the function getrusage not available\n");
+  exit (1);
+  return 0;
+#endif
+}
+
+/* return the time in microseconds of one call of f, averaged over the
+   arguments x and y */
+static double
+time_func (tune_func_t f)
+{
+  unsigned long niter, i, t, t0;
+  double tmin = -1.0;
+  int r;
+
+  /* find a number of iterations that takes long enough to be measured */
+  niter = 1;
+  do {
+     niter *= 2;
+     t0 = get_cputime ();
+     for (i = 0; i < niter; i++)
+        f (z [i % TUNE_NB_ARGS], x [i % TUNE_NB_ARGS], y [i % TUNE_NB_ARGS],
+           MPC_RNDNN);
+     t = get_cputime () - t0;
+  } while (t < TUNE_MIN_TIME);
+
+  for (r = 0; r < TUNE_REPEAT; r++) {
+     t0 = get_cputime ();
+     for (i = 0; i < niter; i++)
+        f (z [i % TUNE_NB_ARGS], x [i % TUNE_NB_ARGS], y [i % TUNE_NB_ARGS],
+           MPC_RNDNN);
+     t = get_cputime () - t0;
+     if (tmin < 0 || t < tmin)
+        tmin = t;
+  }
+
+  return tmin / niter;
+}
+
+static void
+set_prec (mpfr_prec_t prec)
+{
+  int i;
+
+  for (i = 0; i < TUNE_NB_ARGS; i++) {
+     mpc_set_prec (z [i], prec);
+     mpc_set_prec (x [i], prec);
+     mpc_set_prec (y [i], prec);
+  }
+}
+
+/* set both parts of x [i] to random numbers with exponent e, and
+   y [i] to random numbers in [0, 1) */
+static void
+random_args (mpfr_exp_t e)
+{
+  int i;
+
+  for (i = 0; i < TUNE_NB_ARGS; i++) {
+     do
+        mpc_urandom (x [i], state);
+     while (mpfr_zero_p (mpc_realref (x [i]))
+            || mpfr_zero_p (mpc_imagref (x [i])));
+     mpfr_set_exp (mpc_realref (x [i]), e);
+     mpfr_set_exp (mpc_imagref (x [i]), e);
+     mpc_urandom (y [i], state);
+  }
+}
+
+static int
+mul_naive (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+  return mpc_mul_naive (rop, op1, op2, rnd);
+}
+
+static int
+mul_karatsuba3 (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+  return mpc_mul_karatsuba3 (rop, op1, op2, rnd);
+}
+
+static int
+asin_tune (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+  (void) op2;
+  return mpc_asin_tune (rop, op1, rnd);
+}
+
+static int
+eta_tune (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+  (void) op2;
+  return mpc_eta_fund_tune (rop, op1, rnd);
+}
+
+static int
+agm_tune (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+  return mpc_agm_tune (rop, op1, op2, rnd);
+}
+
+/* Return the largest size in limbs up to which the naive multiplication
+   is faster, requiring Karatsuba to be faster for TUNE_MUL_STABLE
+   consecutive sizes to filter out noise. */
+static long
+tune_mul (void)
+{
+  long n, wins = 0;
+  double t1, t2;
+
+  for (n = 1; n <= TUNE_MUL_MAX_LIMBS; n++) {
+     set_prec (n * GMP_NUMB_BITS);
+     random_args (0);
+     t1 = time_func (mul_naive);
+     t2 = time_func (mul_karatsuba3);
+     fprintf (stderr, "mul %3ld limbs: naive %.3f, karatsuba %.3f\n",
+              n, t1, t2);
+     if (t2 < t1) {
+        wins++;
+        if (wins == TUNE_MUL_STABLE)
+           return n - TUNE_MUL_STABLE;
+     }
+     else
+        wins = 0;
+  }
+
+  return TUNE_MUL_MAX_LIMBS;
+}
+
+/* Return the largest exponent e <= -1 such that the series in mpc_asin
+   is faster than the generic formula for arguments of exponent e. */
+static long
+tune_asin_series (void)
+{
+  long e;
+  double t1, t2;
+
+  mpc_tune_asin_large_exp = 2;
+  for (e = -1; e > -64; e--) {
+     random_args (e);
+     mpc_tune_asin_series_exp = e;
+     t1 = time_func (asin_tune);
+     mpc_tune_asin_series_exp = e - 1;
+     t2 = time_func (asin_tune);
+     fprintf (stderr, "asin exponent %3ld: series %.3f, generic %.3f\n",
+              e, t1, t2);
+     if (t1 < t2)
+        return e;
+  }
+
+  return e;
+}
+
+/* Return the smallest exponent e >= 2 such that the asymptotic formula
+   in mpc_asin is faster than the generic one for arguments of exponent
+   e with positive imaginary part. */
+static long
+tune_asin_large (void)
+{
+  long e;
+  double t1, t2;
+
+  mpc_tune_asin_series_exp = -1;
+  for (e = 2; e < 64; e++) {
+     random_args (e);
+     mpc_tune_asin_large_exp = e;
+     t1 = time_func (asin_tune);
+     mpc_tune_asin_large_exp = e + 1;
+     t2 = time_func (asin_tune);
+     fprintf (stderr, "asin exponent %3ld: asymptotic %.3f, generic %.3f\n",
+              e, t1, t2);
+     if (t1 < t2)
+        return e;
+  }
+
+  return e;
+}
+
+/* Return the value of ETA_TERMS_STEP giving the fastest evaluation of
+   eta in the fundamental domain. */
+static long
+tune_eta (void)
+{
+  long step, best = 2;
+  double t, tmin = -1.0;
+  int i;
+
+  /* z = x + i*y with |x| <= 1/2 and 1 <= y < 2 */
+  for (i = 0; i < TUNE_NB_ARGS; i++) {
+     mpc_urandom (x [i], state);
+     mpfr_sub_d (mpc_realref (x [i]), mpc_realref (x [i]), 0.5, MPFR_RNDN);
+     mpfr_add_ui (mpc_imagref (x [i]), mpc_imagref (x [i]), 1, MPFR_RNDN);
+  }
+  for (step = 1; step <= 16; step *= 2) {
+     mpc_tune_eta_terms_step = step;
+     t = time_func (eta_tune);
+     fprintf (stderr, "eta step %2ld: %.3f\n", step, t);
+     if (tmin < 0 || t < tmin) {
+        tmin = t;
+        best = step;
+     }
+  }
+
+  return best;
+}
+
+/* Return the value of AGM_INITIAL_PREC giving the fastest evaluation of
+   agm for random arguments. */
+static long
+tune_agm (void)
+{
+  long prec, best = 2;
+  double t, tmin = -1.0;
+  int i;
+
+  for (i = 0; i < TUNE_NB_ARGS; i++) {
+     mpc_urandom (x [i], state);
+     mpc_urandom (y [i], state);
+  }
+  for (prec = 2; prec <= 256; prec *= 2) {
+     mpc_tune_agm_initial_prec = prec;
+     t = time_func (agm_tune);
+     fprintf (stderr, "agm initial precision %3ld: %.3f\n", prec, t);
+     if (tmin < 0 || t < tmin) {
+        tmin = t;
+        best = prec;
+     }
+  }
+
+  return best;
+}
+
+int
+main (int argc, char *argv[])
+{
+  mpfr_prec_t prec = 256;
+  long mul, asin_series, asin_large, eta, agm;
+  int i;
+
+  if (argc > 1)
+     prec = atol (argv [1]);
+  if (prec < MPFR_PREC_MIN || prec > 100000) {
+     fprintf (stderr, "Usage: tuneup [prec]\n");
+     exit (1);
+  }
+
+  gmp_randinit_default (state);
+  for (i = 0; i < TUNE_NB_ARGS; i++) {
+     mpc_init2 (z [i], 2);
+     mpc_init2 (x [i], 2);
+     mpc_init2 (y [i], 2);
+  }
+
+  mul = tune_mul ();
+  set_prec (prec);
+  asin_series = tune_asin_series ();
+  asin_large = tune_asin_large ();
+  eta = tune_eta ();
+  agm = tune_agm ();
+
+  printf ("/* mpc-tuned.h -- thresholds measured by tuneup, see tools/tune. */\n");
+  printf ("\n");
+  printf ("/* Generated by GNU MPC %s with GMP %s and MPFR %s. */\n",
+          mpc_get_version (), gmp_version, mpfr_get_version ());
+  printf ("\n");
+  printf ("#define MUL_KARATSUBA_THRESHOLD %ld\n", mul);
+  printf ("\n");
+  printf ("/* measured at a precision of %ld bits */\n", (long) prec);
+  printf ("#define ASIN_SERIES_EXP (%ld)\n", asin_series);
+  printf ("#define ASIN_LARGE_EXP %ld\n", asin_large);
+  printf ("#define ETA_TERMS_STEP %ld\n", eta);
+  printf ("#define AGM_INITIAL_PREC %ld\n", agm);
+
+  for (i = 0; i < TUNE_NB_ARGS; i++) {
+     mpc_clear (z [i]);
+     mpc_clear (x [i]);
+     mpc_clear (y [i]);
+  }
+  gmp_randclear (state);
+
+  return 0;
+}
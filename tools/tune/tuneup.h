@@ -0,0 +1,36 @@
+/* tuneup.h -- declarations for the tuneup program.
+
+Copyright (C) 2026 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+/* The library sources compiled into the tuneup program read their
+   thresholds from the following variables instead of the constants of
+   mpc-impl.h, and their entry points are renamed so as not to clash
+   with the functions of the library. */
+
+#define TUNE_PROGRAM_BUILD 1
+
+#define ASIN_SERIES_EXP  mpc_tune_asin_series_exp
+#define ASIN_LARGE_EXP   mpc_tune_asin_large_exp
+#define ETA_TERMS_STEP   mpc_tune_eta_terms_step
+#define AGM_INITIAL_PREC mpc_tune_agm_initial_prec
+
+extern long mpc_tune_asin_series_exp;
+extern long mpc_tune_asin_large_exp;
+extern long mpc_tune_eta_terms_step;
+extern long mpc_tune_agm_initial_prec;